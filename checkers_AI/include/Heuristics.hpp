@@ -1,8 +1,10 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 #include "GameController.hpp"
 #include "IMetricsCalculator.hpp"
+#include "PositionHistory.hpp"
 
 class IStrategy;
 class Heuristics
@@ -29,7 +31,7 @@ public:
 
     bool operator==(const Heuristics&) const;
 
-    GameStateWithMove getMove(const GameState&, FigureColor);
+    std::optional<MoveIndex> getMove(const GameState&, const PossibleMoves&, FigureColor, const PositionHistory&);
 
 private:
     const IStrategy& m_strategy;
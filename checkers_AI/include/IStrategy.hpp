@@ -1,6 +1,8 @@
 #pragma once
 #include <functional>
+#include <optional>
 #include "GameController.hpp"
+#include "PositionHistory.hpp"
 
 using EvaluationFunction = std::function<int(const GameState&, FigureColor)>;
 class IStrategy
@@ -14,6 +16,14 @@ public:
     IStrategy& operator=(const IStrategy&) = default;
     IStrategy& operator=(IStrategy&&) = default;
 
-    virtual GameStateWithMove getMiniMaxMove(const GameState&, EvaluationFunction, FigureColor, unsigned int maxDepth)
-        const = 0;
+    // Searches the given root moves of the game state and returns the index of the best one, if any was chosen.
+    // The game history holds the positions played so far, ending with the game state, and may be empty. Positions
+    // repeating one of them are scored as draws.
+    virtual std::optional<MoveIndex> getMiniMaxMove(
+        const GameState&,
+        const PossibleMoves& rootMoves,
+        EvaluationFunction,
+        FigureColor,
+        unsigned int maxDepth,
+        const PositionHistory& gameHistory) const = 0;
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "MovePicker.hpp"
+
+// Move ordering state of a single search, kept across its iterative deepening depths: the two killer moves of every
+// ply (quiet moves which caused a cutoff in a sibling node) and the history score of every quiet move, which grows
+// with every cutoff the same move caused anywhere in the tree. MovePicker searches moves in the order they give.
+class MoveOrdering
+{
+public:
+    // Hints for the moves of a node at the given ply.
+    MoveHints hints(FigureColor, unsigned int ply, const std::optional<Move>& hashMove) const;
+
+    // Records the move which caused a cutoff at a node with the given remaining depth.
+    void recordCutoff(const Move&, FigureColor, unsigned int ply, unsigned int remainingDepth);
+
+private:
+    using Killers = std::array<std::optional<Move>, 2>;
+
+    static constexpr std::uint32_t historyLimit = 1u << 30;
+
+    MoveHistory& history(FigureColor color) { return m_history[static_cast<std::size_t>(color == FigureColor::Black)]; }
+    const MoveHistory& history(FigureColor color) const
+    {
+        return m_history[static_cast<std::size_t>(color == FigureColor::Black)];
+    }
+
+    std::vector<Killers> m_killers;
+    std::array<MoveHistory, 2> m_history{};
+};
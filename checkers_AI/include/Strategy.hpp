@@ -1,10 +1,47 @@
 #pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include "IStrategy.hpp"
 
+struct SearchOptions
+{
+    // Size of the transposition table owned by every searching thread, zero disables it. Nothing is kept between moves,
+    // so the default of 65536 entries fits a single depth 5 search; deeper searches should ask for more.
+    std::size_t transpositionTableSize{1u * 1024u * 1024u};
+    bool hugePages{false};
+    // Budgets of a single move, zero means unlimited. With either of them set, depths 1, 2, ... up to maxDepth are
+    // searched in turn until the budget runs out, and the best move of the deepest completed depth is returned.
+    std::chrono::milliseconds timeBudget{0};
+    std::uint64_t nodesBudget{0};
+    bool moveOrdering{true};
+};
+
+struct SearchStatistics
+{
+    std::uint64_t nodes{0};
+    std::uint64_t cutoffs{0};
+    // Cutoffs caused by the first move searched at a node, the closer to all cutoffs the better the move ordering.
+    std::uint64_t firstMoveCutoffs{0};
+};
+
 class Strategy : public IStrategy
 {
 public:
-    GameStateWithMove getMiniMaxMove(const GameState&, EvaluationFunction, FigureColor, unsigned int maxDepth)
-        const override;
+    explicit Strategy(SearchOptions options = {});
+
+    std::optional<MoveIndex> getMiniMaxMove(
+        const GameState&,
+        const PossibleMoves& rootMoves,
+        EvaluationFunction,
+        FigureColor,
+        unsigned int maxDepth,
+        const PositionHistory& gameHistory) const override;
+
+    // Statistics of the last search run by the calling thread.
+    static SearchStatistics lastSearchStatistics();
+
+private:
+    const SearchOptions m_options;
 };
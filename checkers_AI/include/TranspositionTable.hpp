@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "Move.hpp"
+
+// Fixed size hash table of searched positions. Entries are grouped into buckets of one cache line, so a probe touches
+// a single line of memory. Scores are valid only for the evaluation function they were computed with, so every search
+// starts a new generation and entries of older ones are treated as empty.
+class TranspositionTable
+{
+public:
+    enum class Bound : std::uint8_t
+    {
+        Exact,
+        Lower,
+        Upper
+    };
+
+    struct Result
+    {
+        int score;
+        unsigned int depth;
+        Bound bound;
+        std::optional<Move> bestMove;
+    };
+
+    // The size is rounded down to a power of two number of buckets, but there is always at least one.
+    // Huge pages are only advised and the table silently falls back to normal pages where they are not available.
+    explicit TranspositionTable(std::size_t sizeInBytes, bool hugePages = false);
+
+    void newSearch();
+    void clear();
+
+    std::optional<Result> probe(std::uint64_t hash) const;
+
+    // Keeps the entry of the same position unless it was searched deeper, otherwise replaces the entry of an older
+    // search or the shallowest one in the bucket. The best move is a fully generated move, only its origin,
+    // destination and captured figures are stored, which is enough to tell legal moves of a position apart.
+    void store(std::uint64_t hash, unsigned int depth, int score, Bound, const Move& bestMove);
+
+    std::size_t bucketsNumber() const { return m_bucketsMask + 1; }
+
+    static constexpr std::size_t entriesPerBucket = 4;
+
+private:
+    struct Entry
+    {
+        std::uint32_t key;
+        std::int32_t score;
+        Move::Bitboard captured;
+        std::uint8_t from;
+        std::uint8_t to;
+        std::uint8_t depth;
+        std::uint8_t generationAndBound;
+    };
+
+    struct alignas(64) Bucket
+    {
+        std::array<Entry, entriesPerBucket> entries;
+    };
+
+    static_assert(sizeof(Bucket) == 64, "Bucket should fill exactly one cache line");
+
+    struct FreeMemory
+    {
+        void operator()(Bucket*) const;
+    };
+
+    static constexpr unsigned int boundBits = 2;
+    static constexpr std::uint8_t boundMask = (1u << boundBits) - 1;
+    static constexpr std::uint8_t generationsNumber = 1u << (8 - boundBits);
+
+    Bucket& bucket(std::uint64_t hash) const { return m_buckets.get()[hash & m_bucketsMask]; }
+    static std::uint32_t key(std::uint64_t hash) { return static_cast<std::uint32_t>(hash >> 32); }
+    std::uint8_t generation(const Entry& entry) const { return entry.generationAndBound >> boundBits; }
+    bool isCurrent(const Entry& entry) const { return entry.depth != 0 && generation(entry) == m_generation; }
+
+    std::unique_ptr<Bucket, FreeMemory> m_buckets;
+    std::size_t m_bucketsMask{0};
+    std::size_t m_sizeInBytes{0};
+    std::uint8_t m_generation{0};
+};
@@ -6,9 +6,9 @@ class StrategyMock : public IStrategy
 {
 public:
     MOCK_METHOD(
-        GameStateWithMove,
+        std::optional<MoveIndex>,
         getMiniMaxMove,
-        (const GameState&, EvaluationFunction, FigureColor, unsigned int),
+        (const GameState&, const PossibleMoves&, EvaluationFunction, FigureColor, unsigned int, const PositionHistory&),
         (const, override));
 };
 class CalculatorMock : public IMetricsCalculator
@@ -28,39 +28,48 @@ bool Heuristics::operator==(const Heuristics& other) const
         m_metricsEarlyGame == other.m_metricsEarlyGame && m_metricsEarlyGame == other.m_metricsEarlyGame;
 }
 
-GameStateWithMove Heuristics::getMove(const GameState& gameState, FigureColor figureColor)
+std::optional<MoveIndex> Heuristics::getMove(
+    const GameState& gameState,
+    const PossibleMoves& possibleMoves,
+    FigureColor figureColor,
+    const PositionHistory& gameHistory)
 {
-    const auto whiteFiguresCount = gameState.pawns(FigureColor::White).size();
-    const auto blackFiguresCount = gameState.pawns(FigureColor::Black).size();
-    const auto totalFiguresCount = whiteFiguresCount + blackFiguresCount;
+    const auto totalFiguresCount = static_cast<unsigned int>(
+        gameState.figuresNumber(FigureColor::White) + gameState.figuresNumber(FigureColor::Black));
     if (totalFiguresCount >= m_earlyGameFiguresLimit)
     {
         return m_strategy.getMiniMaxMove(
             gameState,
+            possibleMoves,
             [this](const GameState& gameState, FigureColor figureColor) {
                 return m_metricsCalculator.evaluate(m_metricsEarlyGame, gameState, figureColor);
             },
             figureColor,
-            m_minimaxDepth);
+            m_minimaxDepth,
+            gameHistory);
     }
     else if (totalFiguresCount >= m_midGameFiguresLimit)
     {
         return m_strategy.getMiniMaxMove(
             gameState,
+            possibleMoves,
             [this](const GameState& gameState, FigureColor figureColor) {
                 return m_metricsCalculator.evaluate(m_metricsMidGame, gameState, figureColor);
             },
             figureColor,
-            m_minimaxDepth);
+            m_minimaxDepth,
+            gameHistory);
     }
     else
     {
         return m_strategy.getMiniMaxMove(
             gameState,
+            possibleMoves,
             [this](const GameState& gameState, FigureColor figureColor) {
                 return m_metricsCalculator.evaluate(m_metricsLateGame, gameState, figureColor);
             },
             figureColor,
-            m_minimaxDepth);
+            m_minimaxDepth,
+            gameHistory);
     }
 }
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <functional>
 
 #include "GameController.hpp"
 
@@ -39,24 +38,19 @@ int calcFiguresRatio(int maxPossiblePoints, int playerPoints, int opponentPoints
         return halfRange;
     }
 }
-void constrainFigures(Figures& figures, std::function<bool(const Figure&)> removeIfPredicate)
+template <typename Predicate>
+int countFigures(const FiguresView& figures, Predicate predicate)
 {
-    figures.erase(std::remove_if(figures.begin(), figures.end(), std::move(removeIfPredicate)), figures.end());
+    return static_cast<int>(std::count_if(figures.begin(), figures.end(), predicate));
 }
 
-int pawnsNumberMetric(Figures player, Figures opponent)
+int pawnsNumberMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    constrainFigures(player, [](const Figure& pawn) { return pawn.state.type != FigureType::Pawn; });
-    constrainFigures(opponent, [](const Figure& pawn) { return pawn.state.type != FigureType::Pawn; });
-
-    return calcFiguresRatio(totalPlayerFiguresNumber, player.size(), opponent.size());
+    return calcFiguresRatio(totalPlayerFiguresNumber, player.pawnsNumber(), opponent.pawnsNumber());
 }
-int kingsNumberMetric(Figures player, Figures opponent)
+int kingsNumberMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    constrainFigures(player, [](const Figure& pawn) { return pawn.state.type != FigureType::King; });
-    constrainFigures(opponent, [](const Figure& pawn) { return pawn.state.type != FigureType::King; });
-
-    return calcFiguresRatio(totalPlayerFiguresNumber, player.size(), opponent.size());
+    return calcFiguresRatio(totalPlayerFiguresNumber, player.kingsNumber(), opponent.kingsNumber());
 }
 
 bool isSafePosition(Position position)
@@ -64,27 +58,21 @@ bool isSafePosition(Position position)
     return position.row == 0 || position.row == (boardSize - 1) || position.col == 0 || position.col == (boardSize - 1);
 }
 
-int safePawnsMetric(Figures player, Figures opponent)
+int safePawnsMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    constrainFigures(player, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::Pawn || !isSafePosition(pawn.position);
-    });
-    constrainFigures(opponent, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::Pawn || !isSafePosition(pawn.position);
-    });
+    const auto isSafePawn = [](const Figure& pawn) {
+        return pawn.state.type == FigureType::Pawn && isSafePosition(pawn.position);
+    };
     constexpr auto maxPossibleSafePawns = 10;
-    return calcFiguresRatio(maxPossibleSafePawns, player.size(), opponent.size());
+    return calcFiguresRatio(maxPossibleSafePawns, countFigures(player, isSafePawn), countFigures(opponent, isSafePawn));
 }
-int safeKingsMetric(Figures player, Figures opponent)
+int safeKingsMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    constrainFigures(player, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::King || !isSafePosition(pawn.position);
-    });
-    constrainFigures(opponent, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::King || !isSafePosition(pawn.position);
-    });
-
-    return calcFiguresRatio(totalPlayerFiguresNumber, player.size(), opponent.size());
+    const auto isSafeKing = [](const Figure& pawn) {
+        return pawn.state.type == FigureType::King && isSafePosition(pawn.position);
+    };
+    return calcFiguresRatio(
+        totalPlayerFiguresNumber, countFigures(player, isSafeKing), countFigures(opponent, isSafeKing));
 }
 
 bool isCenterPosition(Position position)
@@ -92,99 +80,61 @@ bool isCenterPosition(Position position)
     return position.row == boardSize / 2 || position.row == (boardSize / 2 - 1);
 }
 
-int centerPawnsMetric(Figures player, Figures opponent)
+int centerPawnsMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    constrainFigures(player, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::Pawn || !isCenterPosition(pawn.position);
-    });
-    constrainFigures(opponent, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::Pawn || !isCenterPosition(pawn.position);
-    });
-
-    return calcFiguresRatio(totalPlayerFiguresNumber, player.size(), opponent.size());
+    const auto isCenterPawn = [](const Figure& pawn) {
+        return pawn.state.type == FigureType::Pawn && isCenterPosition(pawn.position);
+    };
+    return calcFiguresRatio(
+        totalPlayerFiguresNumber, countFigures(player, isCenterPawn), countFigures(opponent, isCenterPawn));
 }
-int centerKingsMetric(Figures player, Figures opponent)
+int centerKingsMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    constrainFigures(player, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::King || !isCenterPosition(pawn.position);
-    });
-    constrainFigures(opponent, [](const Figure& pawn) {
-        return pawn.state.type != FigureType::King || !isCenterPosition(pawn.position);
-    });
-
-    return calcFiguresRatio(totalPlayerFiguresNumber, player.size(), opponent.size());
+    const auto isCenterKing = [](const Figure& pawn) {
+        return pawn.state.type == FigureType::King && isCenterPosition(pawn.position);
+    };
+    return calcFiguresRatio(
+        totalPlayerFiguresNumber, countFigures(player, isCenterKing), countFigures(opponent, isCenterKing));
 }
 
-int moveableFiguresMetric(
-    const GameState& gameState,
-    const std::vector<GameStateWithMove>& playerMoves,
-    const std::vector<GameStateWithMove>& opponentMoves,
-    FigureType type)
+int moveableFiguresMetric(const GameState& gameState, FigureColor player, FigureColor opponent, FigureType type)
 {
-    std::set<Position> playersPosition;
-    std::set<Position> opponentPosition;
-    for (const auto& move : playerMoves)
-    {
-        if (gameState.pawnAtPosition(move.move.front()).type == type)
-        {
-            playersPosition.insert(move.move.front());
-        }
-    }
-    for (const auto& move : opponentMoves)
-    {
-        if (gameState.pawnAtPosition(move.move.front()).type == type)
-        {
-            opponentPosition.insert(move.move.front());
-        }
-    }
-    return calcFiguresRatio(totalPlayerFiguresNumber, playersPosition.size(), opponentPosition.size());
+    GameController gameController(gameState);
+    return calcFiguresRatio(
+        totalPlayerFiguresNumber,
+        bitboard::popCount(gameController.movablePiecesMask(player, type)),
+        bitboard::popCount(gameController.movablePiecesMask(opponent, type)));
 }
 int moveablePawnsMetric(const GameState& gameState, FigureColor player, FigureColor opponent)
 {
-    GameController gameController(gameState);
-    return moveableFiguresMetric(
-        gameState,
-        gameController.getPossibleMoves(player),
-        gameController.getPossibleMoves(opponent),
-        FigureType::Pawn);
+    return moveableFiguresMetric(gameState, player, opponent, FigureType::Pawn);
 }
 int moveableKingsMetric(const GameState& gameState, FigureColor player, FigureColor opponent)
 {
-    GameController gameController(gameState);
-    return moveableFiguresMetric(
-        gameState,
-        gameController.getPossibleMoves(player),
-        gameController.getPossibleMoves(opponent),
-        FigureType::King);
+    return moveableFiguresMetric(gameState, player, opponent, FigureType::King);
 }
 
-int aggregatedDistanceToPromotionLineMetric(Figures player, Figures opponent)
+int aggregatedDistanceToPromotionLineMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    Figures whitePawns;
-    Figures blackPawns;
-    const bool isPlayerWhiteColor = player.at(0).state.color == FigureColor::White;
-    if (isPlayerWhiteColor)
-    {
-        whitePawns = std::move(player);
-        blackPawns = std::move(opponent);
-    }
-    else
-    {
-        whitePawns = std::move(opponent);
-        blackPawns = std::move(player);
-    }
-    constrainFigures(whitePawns, [](const Figure& pawn) { return pawn.state.type != FigureType::Pawn; });
-    constrainFigures(blackPawns, [](const Figure& pawn) { return pawn.state.type != FigureType::Pawn; });
+    const bool isPlayerWhiteColor = player.color() == FigureColor::White;
+    const auto& whiteFigures = isPlayerWhiteColor ? player : opponent;
+    const auto& blackFigures = isPlayerWhiteColor ? opponent : player;
 
     unsigned int playerTotalSum = 0;
     unsigned int maxDistanceSum = 0;
     unsigned int minDistanceSum = 0;
     constexpr auto pawnsPerRow = boardSize / 2;
-    for (size_t i = 0; i < whitePawns.size(); i++)
+    unsigned int i = 0;
+    for (const auto& figure : whiteFigures)
     {
+        if (figure.state.type != FigureType::Pawn)
+        {
+            continue;
+        }
         minDistanceSum += (i / pawnsPerRow);
-        playerTotalSum += whitePawns[i].position.row;
+        playerTotalSum += figure.position.row;
         maxDistanceSum += (boardSize - 2) - (i / pawnsPerRow);
+        i++;
     }
     const double whiteFactor =
         static_cast<double>(playerTotalSum - minDistanceSum) / static_cast<double>(maxDistanceSum - minDistanceSum);
@@ -192,11 +142,17 @@ int aggregatedDistanceToPromotionLineMetric(Figures player, Figures opponent)
     maxDistanceSum = 0;
     playerTotalSum = 0;
     minDistanceSum = 0;
-    for (size_t i = 0; i < blackPawns.size(); i++)
+    i = 0;
+    for (const auto& figure : blackFigures)
     {
+        if (figure.state.type != FigureType::Pawn)
+        {
+            continue;
+        }
         minDistanceSum += (i / pawnsPerRow) + 1;
-        playerTotalSum += blackPawns[i].position.row;
+        playerTotalSum += figure.position.row;
         maxDistanceSum += (boardSize - 1) - (i / pawnsPerRow);
+        i++;
     }
     const double blackFactor =
         static_cast<double>(maxDistanceSum - playerTotalSum) / static_cast<double>(maxDistanceSum - minDistanceSum);
@@ -241,85 +197,87 @@ int numberOfUnoccupiedFieldsOnPromotionLineMetric(FigureColor playerColor, const
         return calcFiguresRatio(maxPossibleUnoccupiedFields, blackPlayerUnoccupiedFields, whitePlayerUnoccupiedFields);
     }
 }
-int defenderFiguresMetric(Figures player, Figures opponent)
+bool isOnWhiteSide(const Figure& figure)
+{
+    return figure.position.row <= (boardSize / 2 - 2);
+}
+bool isOnBlackSide(const Figure& figure)
+{
+    return figure.position.row >= (boardSize / 2 + 1);
+}
+int defenderFiguresMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    const auto isPlayerWhite = player.at(0).state.color == FigureColor::White;
+    const auto isPlayerWhite = player.color() == FigureColor::White;
     if (isPlayerWhite)
     {
-        constrainFigures(player, [](const Figure& figure) { return figure.position.row > (boardSize / 2 - 2); });
-        constrainFigures(opponent, [](const Figure& figure) { return figure.position.row < (boardSize / 2 + 1); });
-    }
-    else
-    {
-        constrainFigures(opponent, [](const Figure& figure) { return figure.position.row > (boardSize / 2 - 2); });
-        constrainFigures(player, [](const Figure& figure) { return figure.position.row < (boardSize / 2 + 1); });
+        return calcFiguresRatio(
+            totalPlayerFiguresNumber, countFigures(player, isOnWhiteSide), countFigures(opponent, isOnBlackSide));
     }
-    return calcFiguresRatio(totalPlayerFiguresNumber, player.size(), opponent.size());
+    return calcFiguresRatio(
+        totalPlayerFiguresNumber, countFigures(player, isOnBlackSide), countFigures(opponent, isOnWhiteSide));
 }
-int attackingFiguresMetric(Figures player, Figures opponent)
+int attackingFiguresMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    const auto isPlayerWhite = player.at(0).state.color == FigureColor::White;
+    const auto isPlayerWhite = player.color() == FigureColor::White;
     if (!isPlayerWhite)
     {
-        constrainFigures(player, [](const Figure& figure) { return figure.position.row > (boardSize / 2 - 2); });
-        constrainFigures(opponent, [](const Figure& figure) { return figure.position.row < (boardSize / 2 + 1); });
-    }
-    else
-    {
-        constrainFigures(opponent, [](const Figure& figure) { return figure.position.row > (boardSize / 2 - 2); });
-        constrainFigures(player, [](const Figure& figure) { return figure.position.row < (boardSize / 2 + 1); });
+        return calcFiguresRatio(
+            totalPlayerFiguresNumber, countFigures(player, isOnWhiteSide), countFigures(opponent, isOnBlackSide));
     }
-    return calcFiguresRatio(totalPlayerFiguresNumber, player.size(), opponent.size());
+    return calcFiguresRatio(
+        totalPlayerFiguresNumber, countFigures(player, isOnBlackSide), countFigures(opponent, isOnWhiteSide));
 }
 
 bool isDiagonalPosition(Position position)
 {
     return position.row == position.col;
 }
-int figuresOnDiagonalMetric(Figures player, Figures opponent, FigureType type, int maxNumberOfFiguresOnDiagonal)
+int figuresOnDiagonalMetric(
+    const FiguresView& player,
+    const FiguresView& opponent,
+    FigureType type,
+    int maxNumberOfFiguresOnDiagonal)
 {
-    constrainFigures(player, [type](const Figure& figure) {
-        return !isDiagonalPosition(figure.position) || figure.state.type != type;
-    });
-    constrainFigures(opponent, [type](const Figure& figure) {
-        return !isDiagonalPosition(figure.position) || figure.state.type != type;
-    });
-
-    return calcFiguresRatio(maxNumberOfFiguresOnDiagonal, player.size(), opponent.size());
+    const auto isOnDiagonal = [type](const Figure& figure) {
+        return isDiagonalPosition(figure.position) && figure.state.type == type;
+    };
+    return calcFiguresRatio(
+        maxNumberOfFiguresOnDiagonal, countFigures(player, isOnDiagonal), countFigures(opponent, isOnDiagonal));
 }
-int pawnsOnDiagonalMetric(Figures player, Figures opponent)
+int pawnsOnDiagonalMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    return figuresOnDiagonalMetric(std::move(player), std::move(opponent), FigureType::Pawn, boardSize - 1);
+    return figuresOnDiagonalMetric(player, opponent, FigureType::Pawn, boardSize - 1);
 }
-int kingsOnDiagonalMetric(Figures player, Figures opponent)
+int kingsOnDiagonalMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    return figuresOnDiagonalMetric(std::move(player), std::move(opponent), FigureType::King, boardSize);
+    return figuresOnDiagonalMetric(player, opponent, FigureType::King, boardSize);
 }
 
 bool isDoubleDiagonalPosition(Position position)
 {
     return (position.row == position.col + 2) || (position.row == position.col - 2);
 }
-int figuresOnDoubleDiagonalMetric(Figures player, Figures opponent, FigureType type, int maxNumberOfFiguresOnDiagonal)
+int figuresOnDoubleDiagonalMetric(
+    const FiguresView& player,
+    const FiguresView& opponent,
+    FigureType type,
+    int maxNumberOfFiguresOnDiagonal)
 {
-    constrainFigures(player, [type](const Figure& figure) {
-        return !isDoubleDiagonalPosition(figure.position) || figure.state.type != type;
-    });
-    constrainFigures(opponent, [type](const Figure& figure) {
-        return !isDoubleDiagonalPosition(figure.position) || figure.state.type != type;
-    });
-
-    return calcFiguresRatio(maxNumberOfFiguresOnDiagonal, player.size(), opponent.size());
+    const auto isOnDoubleDiagonal = [type](const Figure& figure) {
+        return isDoubleDiagonalPosition(figure.position) && figure.state.type == type;
+    };
+    return calcFiguresRatio(
+        maxNumberOfFiguresOnDiagonal,
+        countFigures(player, isOnDoubleDiagonal),
+        countFigures(opponent, isOnDoubleDiagonal));
 }
-int pawnsOnDoubleDiagonalMetric(Figures player, Figures opponent)
+int pawnsOnDoubleDiagonalMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    return figuresOnDoubleDiagonalMetric(
-        std::move(player), std::move(opponent), FigureType::Pawn, totalPlayerFiguresNumber - 1);
+    return figuresOnDoubleDiagonalMetric(player, opponent, FigureType::Pawn, totalPlayerFiguresNumber - 1);
 }
-int kingsOnDoubleDiagonalMetric(Figures player, Figures opponent)
+int kingsOnDoubleDiagonalMetric(const FiguresView& player, const FiguresView& opponent)
 {
-    return figuresOnDoubleDiagonalMetric(
-        std::move(player), std::move(opponent), FigureType::King, totalPlayerFiguresNumber);
+    return figuresOnDoubleDiagonalMetric(player, opponent, FigureType::King, totalPlayerFiguresNumber);
 }
 
 int patternMetric(FigureColor playerColor, bool whitePatternSatisfied, bool blackPatternSatisfied)
@@ -461,8 +419,8 @@ unsigned int MetricsCalculator::evaluate(
     FigureColor playerColor) const
 {
     const FigureColor opponentColor = FigureState::flipColor(playerColor);
-    const auto playerFigures = gameState.pawns(playerColor);
-    const auto opponentFigures = gameState.pawns(opponentColor);
+    const auto playerFigures = gameState.figuresView(playerColor);
+    const auto opponentFigures = gameState.figuresView(opponentColor);
     if (metricWithFactors.empty())
     {
         return Calculator::minValue;
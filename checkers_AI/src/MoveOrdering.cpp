@@ -0,0 +1,45 @@
+#include "MoveOrdering.hpp"
+
+MoveHints MoveOrdering::hints(FigureColor color, unsigned int ply, const std::optional<Move>& hashMove) const
+{
+    MoveHints hints{hashMove, {}, &history(color)};
+    if (ply < m_killers.size())
+    {
+        hints.killers = m_killers[ply];
+    }
+    return hints;
+}
+
+void MoveOrdering::recordCutoff(const Move& move, FigureColor color, unsigned int ply, unsigned int remainingDepth)
+{
+    // Captures are searched first anyway, so only quiet moves are remembered.
+    if (move.captured != 0u)
+    {
+        return;
+    }
+
+    if (m_killers.size() <= ply)
+    {
+        m_killers.resize(ply + 1);
+    }
+    auto& killers = m_killers[ply];
+    if (!killers[0] || !MovePicker::isSameMove(*killers[0], move))
+    {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+
+    auto& colorHistory = history(color);
+    auto& score = colorHistory[move.from][move.to];
+    score += remainingDepth * remainingDepth;
+    if (score >= historyLimit)
+    {
+        for (auto& scores : colorHistory)
+        {
+            for (auto& historyScore : scores)
+            {
+                historyScore /= 2;
+            }
+        }
+    }
+}
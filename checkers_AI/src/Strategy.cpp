@@ -1,90 +1,359 @@
 #include "Strategy.hpp"
+#include "MoveOrdering.hpp"
+#include "MovePicker.hpp"
+#include "PositionHistory.hpp"
+#include "TranspositionTable.hpp"
 
-std::pair<int, GameStateWithMove> alphabeta(
-    const GameState& gamestate,
-    const EvaluationFunction& evalFunction,
-    FigureColor callingPlayer,
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+// Counts the nodes searched for a move and tells when its time or node budget is spent. Nothing is stopped before
+// enforce() is called, so the first depth always completes. The clock is read only every few nodes, as reading it
+// costs more than searching a node.
+class Budget
+{
+public:
+    explicit Budget(const SearchOptions& options)
+        : m_nodesLimit(options.nodesBudget)
+        , m_timeLimited(options.timeBudget.count() > 0)
+        , m_deadline(std::chrono::steady_clock::now() + options.timeBudget)
+    {
+    }
+
+    bool isLimited() const { return m_nodesLimit != 0 || m_timeLimited; }
+
+    void enforce() { m_enforced = true; }
+
+    // Counts a searched node and tells whether the search has to stop.
+    bool spendNode()
+    {
+        m_nodes++;
+        return m_nodes % clockInterval == 0 || m_nodes == m_nodesLimit ? checkExhausted() : m_exhausted;
+    }
+
+    bool checkExhausted()
+    {
+        if (m_enforced && !m_exhausted)
+        {
+            m_exhausted = (m_nodesLimit != 0 && m_nodes >= m_nodesLimit) ||
+                (m_timeLimited && std::chrono::steady_clock::now() >= m_deadline);
+        }
+        return m_exhausted;
+    }
+
+    bool exhausted() const { return m_exhausted; }
+
+    std::uint64_t nodes() const { return m_nodes; }
+
+private:
+    static constexpr std::uint64_t clockInterval = 1024;
+
+    const std::uint64_t m_nodesLimit;
+    const bool m_timeLimited;
+    const std::chrono::steady_clock::time_point m_deadline;
+    std::uint64_t m_nodes{0};
+    bool m_enforced{false};
+    bool m_exhausted{false};
+};
+
+// State shared by every node of a single search.
+struct Search
+{
+    PositionHistory& positionHistory;
+    const EvaluationFunction& evalFunction;
+    const FigureColor callingPlayer;
+    const unsigned int maxDepth;
+    TranspositionTable* const transpositionTable;
+    MoveOrdering* const moveOrdering;
+    Budget& budget;
+    SearchStatistics& statistics;
+    // Draws by repetition scored so far. A node below which this grows has a score which depends on the path to it.
+    std::uint64_t repetitionDraws{0};
+};
+
+std::pair<int, Move> alphabeta(
+    GameState& gamestate,
+    Search& search,
+    FigureColor currentPlayer,
+    unsigned int currentDepth,
+    int alpha,
+    int beta);
+
+// Evaluation functions have no common scale, so a draw is scored halfway between both players' view of the position.
+int drawScore(const GameState& gameState, const EvaluationFunction& evalFunction, FigureColor callingPlayer)
+{
+    const auto playerScore = evalFunction(gameState, callingPlayer);
+    const auto opponentScore = evalFunction(gameState, FigureState::flipColor(callingPlayer));
+    return playerScore / 2 + opponentScore / 2;
+}
+
+// Scores the position after the move. A position repeated since the last irreversible move is scored as a draw
+// without being expanded.
+int searchMove(
+    GameState& gamestate,
+    const Move& move,
+    Search& search,
     FigureColor currentPlayer,
-    const unsigned int maxDepth,
     unsigned int currentDepth,
     int alpha,
     int beta)
 {
-    const GameController gameController(gamestate);
-    const auto possibleMoves = gameController.getPossibleMoves(currentPlayer);
-    if (currentDepth == maxDepth || possibleMoves.empty())
+    const auto irreversible = PositionHistory::isIrreversible(gamestate, move);
+    const auto undoRecord = gamestate.makeMove(move);
+    const auto nextPlayer = FigureState::flipColor(currentPlayer);
+    const auto hash = gamestate.hash(nextPlayer);
+    int score = 0;
+    if (!irreversible && search.positionHistory.occurrences(hash) > 0)
+    {
+        score = drawScore(gamestate, search.evalFunction, search.callingPlayer);
+        search.repetitionDraws++;
+    }
+    else
+    {
+        search.positionHistory.push(hash, irreversible);
+        score = alphabeta(gamestate, search, nextPlayer, currentDepth + 1, alpha, beta).first;
+        search.positionHistory.pop();
+    }
+    gamestate.unmakeMove(move, undoRecord);
+    return score;
+}
+
+// Scores are kept from the calling player's point of view, so the bound of a result depends only on the window it was
+// searched with.
+TranspositionTable::Bound boundOf(int score, int alpha, int beta)
+{
+    if (score <= alpha)
+    {
+        return TranspositionTable::Bound::Upper;
+    }
+    if (score >= beta)
     {
-        return {evalFunction(gamestate, callingPlayer), {}};
+        return TranspositionTable::Bound::Lower;
     }
+    return TranspositionTable::Bound::Exact;
+}
 
-    GameStateWithMove bestMove;
-    if (callingPlayer == currentPlayer)
+std::pair<int, Move> alphabeta(
+    GameState& gamestate,
+    Search& search,
+    FigureColor currentPlayer,
+    unsigned int currentDepth,
+    int alpha,
+    int beta)
+{
+    // The score of a stopped search is never used, so there is nothing to compute.
+    if (search.budget.spendNode())
+    {
+        return {0, {}};
+    }
+    if (currentDepth == search.maxDepth)
+    {
+        return {search.evalFunction(gamestate, search.callingPlayer), {}};
+    }
+    const auto remainingDepth = search.maxDepth - currentDepth;
+    const auto hash = gamestate.hash(currentPlayer);
+    std::optional<Move> hashMove;
+    if (search.transpositionTable != nullptr)
     {
-        for (const auto& possibleMove : possibleMoves)
+        const auto entry = search.transpositionTable->probe(hash);
+        if (entry && entry->depth >= remainingDepth &&
+            (entry->bound == TranspositionTable::Bound::Exact ||
+             (entry->bound == TranspositionTable::Bound::Lower && entry->score >= beta) ||
+             (entry->bound == TranspositionTable::Bound::Upper && entry->score <= alpha)))
         {
-            const auto ab = alphabeta(
-                possibleMove.gameState,
-                evalFunction,
-                callingPlayer,
-                FigureState::flipColor(currentPlayer),
-                maxDepth,
-                currentDepth + 1,
-                alpha,
-                beta);
-            if (ab.first > alpha)
-            {
-                alpha = ab.first;
-                bestMove = possibleMove;
-            }
-            if (alpha >= beta)
-            {
-                return {alpha, possibleMove};
-            }
+            return {entry->score, {}};
+        }
+        if (entry)
+        {
+            hashMove = entry->bestMove;
         }
-        return {alpha, bestMove};
     }
-    else
+
+    // The hash move is tried before any move is generated, so a cutoff on it costs no move generation at all.
+    MoveHints hints;
+    if (search.moveOrdering != nullptr)
+    {
+        hints = search.moveOrdering->hints(currentPlayer, currentDepth, hashMove);
+    }
+    MovePicker movePicker(gamestate, currentPlayer, hints);
+    const auto originalAlpha = alpha;
+    const auto originalBeta = beta;
+    const auto originalRepetitionDraws = search.repetitionDraws;
+    const auto maximizing = search.callingPlayer == currentPlayer;
+    Move bestMove;
+    std::size_t searchedMoves = 0;
+    for (auto possibleMove = movePicker.nextMove(); possibleMove; possibleMove = movePicker.nextMove())
     {
-        for (const auto& possibleMove : possibleMoves)
+        searchedMoves++;
+        const auto score = searchMove(gamestate, *possibleMove, search, currentPlayer, currentDepth, alpha, beta);
+        if (search.budget.exhausted())
+        {
+            return {0, {}};
+        }
+        if (maximizing && score > alpha)
+        {
+            alpha = score;
+            bestMove = *possibleMove;
+        }
+        else if (!maximizing && score < beta)
         {
-            const auto ab = alphabeta(
-                possibleMove.gameState,
-                evalFunction,
-                callingPlayer,
-                FigureState::flipColor(currentPlayer),
-                maxDepth,
-                currentDepth + 1,
-                alpha,
-                beta);
-            if (ab.first < beta)
+            beta = score;
+            bestMove = *possibleMove;
+        }
+        if (alpha >= beta)
+        {
+            search.statistics.cutoffs++;
+            search.statistics.firstMoveCutoffs += searchedMoves == 1 ? 1 : 0;
+            if (search.moveOrdering != nullptr)
             {
-                beta = ab.first;
-                bestMove = possibleMove;
+                search.moveOrdering->recordCutoff(*possibleMove, currentPlayer, currentDepth, remainingDepth);
             }
+            break;
+        }
+    }
 
-            if (alpha >= beta)
-            {
-                return {beta, possibleMove};
-            }
+    if (searchedMoves == 0)
+    {
+        return {search.evalFunction(gamestate, search.callingPlayer), {}};
+    }
+
+    const auto score = maximizing ? alpha : beta;
+    // A draw by repetition below makes the score valid only for the path searched, so it is not reused elsewhere.
+    if (search.transpositionTable != nullptr && search.repetitionDraws == originalRepetitionDraws)
+    {
+        search.transpositionTable->store(
+            hash, remainingDepth, score, boundOf(score, originalAlpha, originalBeta), bestMove);
+    }
+    return {score, bestMove};
+}
+
+// Searches the root moves in the given order and returns the best one. With equal scores the first one searched wins.
+std::optional<MoveIndex> searchRoot(
+    const GameState& gameState,
+    const PossibleMoves& rootMoves,
+    const std::vector<MoveIndex>& order,
+    Search& search)
+{
+    std::optional<MoveIndex> bestMove;
+    auto alpha = std::numeric_limits<int>::min();
+    const auto beta = std::numeric_limits<int>::max();
+    auto searchedGameState = gameState;
+    for (const auto moveIndex : order)
+    {
+        const auto score =
+            searchMove(searchedGameState, rootMoves[moveIndex].move, search, search.callingPlayer, 0u, alpha, beta);
+        if (search.budget.exhausted())
+        {
+            break;
+        }
+        if (score > alpha)
+        {
+            alpha = score;
+            bestMove = moveIndex;
+        }
+        if (alpha >= beta)
+        {
+            break;
         }
-        return {beta, bestMove};
     }
+    return bestMove;
 }
 
-GameStateWithMove Strategy::getMiniMaxMove(
+SearchStatistics& threadStatistics()
+{
+    thread_local SearchStatistics statistics;
+    return statistics;
+}
+
+// A single Strategy is shared by all games played in parallel, so every searching thread owns its table. The table is
+// freed when its thread ends, which for ParrarelGamePlay happens once all games of play() are over.
+TranspositionTable* threadTranspositionTable(const SearchOptions& options)
+{
+    thread_local std::unique_ptr<TranspositionTable> table;
+    thread_local SearchOptions tableOptions;
+    if (options.transpositionTableSize == 0)
+    {
+        return nullptr;
+    }
+    if (!table || options.transpositionTableSize != tableOptions.transpositionTableSize ||
+        options.hugePages != tableOptions.hugePages)
+    {
+        table = std::make_unique<TranspositionTable>(options.transpositionTableSize, options.hugePages);
+        tableOptions = options;
+    }
+    return table.get();
+}
+} // namespace
+
+Strategy::Strategy(SearchOptions options) : m_options(options) {}
+
+std::optional<MoveIndex> Strategy::getMiniMaxMove(
     const GameState& gameState,
+    const PossibleMoves& rootMoves,
     EvaluationFunction evalFunction,
     FigureColor figureColor,
-    unsigned int maxDepth) const
+    unsigned int maxDepth,
+    const PositionHistory& gameHistory) const
+{
+    if (maxDepth == 0)
+    {
+        return std::nullopt;
+    }
+    auto positionHistory = gameHistory;
+    if (positionHistory.empty())
+    {
+        positionHistory.push(gameState.hash(figureColor), true);
+    }
+    auto* transpositionTable = threadTranspositionTable(m_options);
+    if (transpositionTable != nullptr)
+    {
+        // Stored scores are only meaningful for the evaluation function they were computed with.
+        transpositionTable->newSearch();
+    }
+
+    // Without a budget only maxDepth is searched. Otherwise every depth starts with the best move of the previous one,
+    // and a depth stopped by the budget is thrown away.
+    Budget budget(m_options);
+    MoveOrdering moveOrdering;
+    auto& statistics = threadStatistics();
+    statistics = SearchStatistics{};
+    std::vector<MoveIndex> order(rootMoves.size());
+    std::iota(order.begin(), order.end(), MoveIndex{0});
+    std::optional<MoveIndex> bestMove;
+    for (auto depth = budget.isLimited() ? 1u : maxDepth; depth <= maxDepth && !budget.checkExhausted(); depth++)
+    {
+        Search search{
+            positionHistory,
+            evalFunction,
+            figureColor,
+            depth,
+            transpositionTable,
+            m_options.moveOrdering ? &moveOrdering : nullptr,
+            budget,
+            statistics};
+        const auto depthBestMove = searchRoot(gameState, rootMoves, order, search);
+        if (budget.exhausted())
+        {
+            break;
+        }
+        bestMove = depthBestMove;
+        budget.enforce();
+        if (bestMove)
+        {
+            const auto bestMovePosition = std::find(order.begin(), order.end(), *bestMove);
+            std::rotate(order.begin(), bestMovePosition, bestMovePosition + 1);
+        }
+    }
+    statistics.nodes = budget.nodes();
+    return bestMove;
+}
+
+SearchStatistics Strategy::lastSearchStatistics()
 {
-    return alphabeta(
-               gameState,
-               evalFunction,
-               figureColor,
-               figureColor,
-               maxDepth,
-               0u,
-               std::numeric_limits<int>::min(),
-               std::numeric_limits<int>::max())
-        .second;
+    return threadStatistics();
 }
@@ -0,0 +1,117 @@
+#include "TranspositionTable.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+constexpr std::size_t hugePageSize = 2u * 1024u * 1024u;
+}
+
+TranspositionTable::TranspositionTable(std::size_t sizeInBytes, bool hugePages)
+{
+    std::size_t bucketsNumber = 1;
+    while (bucketsNumber * 2 * sizeof(Bucket) <= sizeInBytes)
+    {
+        bucketsNumber *= 2;
+    }
+    m_bucketsMask = bucketsNumber - 1;
+
+    // aligned_alloc needs a size which is a multiple of the alignment, so a small table still takes a whole huge page.
+    const auto alignment = hugePages ? hugePageSize : alignof(Bucket);
+    m_sizeInBytes = (bucketsNumber * sizeof(Bucket) + alignment - 1) / alignment * alignment;
+    auto* memory = std::aligned_alloc(alignment, m_sizeInBytes);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (hugePages)
+    {
+        madvise(memory, m_sizeInBytes, MADV_HUGEPAGE);
+    }
+#endif
+    m_buckets.reset(static_cast<Bucket*>(memory));
+    std::uninitialized_fill_n(m_buckets.get(), bucketsNumber, Bucket{});
+}
+
+void TranspositionTable::FreeMemory::operator()(Bucket* buckets) const
+{
+    std::free(buckets); // NOLINT
+}
+
+void TranspositionTable::newSearch()
+{
+    m_generation = static_cast<std::uint8_t>((m_generation + 1) % generationsNumber);
+    // Once the generation wraps around, entries of a search long ago would look current again.
+    if (m_generation == 0)
+    {
+        clear();
+    }
+}
+
+void TranspositionTable::clear()
+{
+    std::fill_n(m_buckets.get(), bucketsNumber(), Bucket{});
+}
+
+std::optional<TranspositionTable::Result> TranspositionTable::probe(std::uint64_t hash) const
+{
+    const auto& entries = bucket(hash).entries;
+    const auto positionKey = key(hash);
+    const auto entry = std::find_if(entries.begin(), entries.end(), [this, positionKey](const Entry& entry) {
+        return isCurrent(entry) && entry.key == positionKey;
+    });
+    if (entry == entries.end())
+    {
+        return std::nullopt;
+    }
+
+    Result result{entry->score, entry->depth, static_cast<Bound>(entry->generationAndBound & boundMask), std::nullopt};
+    if (entry->from != entry->to || entry->captured != 0u)
+    {
+        auto bestMove = Move::startingAt(entry->from);
+        bestMove.to = entry->to;
+        bestMove.captured = entry->captured;
+        result.bestMove = bestMove;
+    }
+    return result;
+}
+
+void TranspositionTable::store(std::uint64_t hash, unsigned int depth, int score, Bound bound, const Move& bestMove)
+{
+    if (depth == 0)
+    {
+        return;
+    }
+    auto& entries = bucket(hash).entries;
+    const auto positionKey = key(hash);
+    auto replaced = std::find_if(entries.begin(), entries.end(), [this, positionKey](const Entry& entry) {
+        return isCurrent(entry) && entry.key == positionKey;
+    });
+    if (replaced != entries.end() && replaced->depth > depth)
+    {
+        return;
+    }
+    if (replaced == entries.end())
+    {
+        replaced = std::min_element(entries.begin(), entries.end(), [this](const Entry& lhs, const Entry& rhs) {
+            return std::make_pair(isCurrent(lhs), lhs.depth) < std::make_pair(isCurrent(rhs), rhs.depth);
+        });
+    }
+
+    replaced->key = positionKey;
+    replaced->score = score;
+    replaced->captured = bestMove.captured;
+    replaced->from = bestMove.from;
+    replaced->to = bestMove.to;
+    replaced->depth = static_cast<std::uint8_t>(std::min(depth, 255u));
+    replaced->generationAndBound =
+        static_cast<std::uint8_t>((m_generation << boundBits) | static_cast<unsigned int>(bound));
+}
@@ -48,9 +48,9 @@ TEST_F(HeuristicsTests, ShouldUseAppriopriateMetricWithFactorsDependingOnGamePro
 
     EvaluationFunction evalFunction;
 
-    EXPECT_CALL(strategyMock, getMiniMaxMove(earlyGameGameState, _, FigureColor::White, minimaxDeep))
-        .WillOnce(DoAll(SaveArg<1>(&evalFunction), Return(GameStateWithMove{})));
-    sut.getMove(earlyGameGameState, FigureColor::White);
+    EXPECT_CALL(strategyMock, getMiniMaxMove(earlyGameGameState, _, _, FigureColor::White, minimaxDeep, _))
+        .WillOnce(DoAll(SaveArg<2>(&evalFunction), Return(std::nullopt)));
+    sut.getMove(earlyGameGameState, {}, FigureColor::White, {});
     EXPECT_CALL(calculatorMock, evaluate(metricsEarlyGame, earlyGameGameState, FigureColor::White));
     evalFunction(earlyGameGameState, FigureColor::White);
 
@@ -62,9 +62,9 @@ TEST_F(HeuristicsTests, ShouldUseAppriopriateMetricWithFactorsDependingOnGamePro
     boardMidGame[1][1] = FigureState{FigureColor::Black};
     GameState midGameGameState{std::move(boardMidGame)};
 
-    EXPECT_CALL(strategyMock, getMiniMaxMove(midGameGameState, _, FigureColor::White, minimaxDeep))
-        .WillOnce(DoAll(SaveArg<1>(&evalFunction), Return(GameStateWithMove{})));
-    sut.getMove(midGameGameState, FigureColor::White);
+    EXPECT_CALL(strategyMock, getMiniMaxMove(midGameGameState, _, _, FigureColor::White, minimaxDeep, _))
+        .WillOnce(DoAll(SaveArg<2>(&evalFunction), Return(std::nullopt)));
+    sut.getMove(midGameGameState, {}, FigureColor::White, {});
     EXPECT_CALL(calculatorMock, evaluate(metricsMidGame, midGameGameState, FigureColor::White));
     evalFunction(midGameGameState, FigureColor::White);
 
@@ -74,9 +74,9 @@ TEST_F(HeuristicsTests, ShouldUseAppriopriateMetricWithFactorsDependingOnGamePro
     boardEarlyGame[0][4] = FigureState{FigureColor::Black};
     GameState lateGameGameState{std::move(lateEarlyGame)};
 
-    EXPECT_CALL(strategyMock, getMiniMaxMove(lateGameGameState, _, FigureColor::White, minimaxDeep))
-        .WillOnce(DoAll(SaveArg<1>(&evalFunction), Return(GameStateWithMove{})));
+    EXPECT_CALL(strategyMock, getMiniMaxMove(lateGameGameState, _, _, FigureColor::White, minimaxDeep, _))
+        .WillOnce(DoAll(SaveArg<2>(&evalFunction), Return(std::nullopt)));
     EXPECT_CALL(calculatorMock, evaluate(metricsLateGame, lateGameGameState, FigureColor::White));
-    sut.getMove(lateGameGameState, FigureColor::White);
+    sut.getMove(lateGameGameState, {}, FigureColor::White, {});
     evalFunction(lateGameGameState, FigureColor::White);
 }
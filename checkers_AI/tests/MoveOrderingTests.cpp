@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "MoveOrdering.hpp"
+
+namespace
+{
+Move quietMove(int from, int to)
+{
+    auto move = Move::startingAt(from);
+    move.addLanding(to);
+    return move;
+}
+
+Move jump(int from, int to, std::initializer_list<int> captured)
+{
+    auto move = quietMove(from, to);
+    for (const auto square : captured)
+    {
+        move.captured |= bitboard::squareMask<DefaultRules>(square);
+    }
+    return move;
+}
+
+using Killers = std::array<std::optional<Move>, 2>;
+} // namespace
+
+TEST(MoveOrdering, ShouldGiveOnlyHashMoveWithoutAnyKnowledge)
+{
+    const auto hashMove = quietMove(8, 12);
+    const MoveOrdering moveOrdering;
+    const auto hints = moveOrdering.hints(FigureColor::White, 1, hashMove);
+    EXPECT_EQ(hints.hashMove, hashMove);
+    EXPECT_EQ(hints.killers, Killers{});
+    ASSERT_NE(hints.history, nullptr);
+    EXPECT_EQ((*hints.history)[8][12], 0u);
+}
+
+TEST(MoveOrdering, ShouldKeepTwoLatestKillersOfPly)
+{
+    const auto first = quietMove(20, 24);
+    const auto second = quietMove(21, 25);
+    const auto third = quietMove(22, 26);
+
+    MoveOrdering moveOrdering;
+    moveOrdering.recordCutoff(first, FigureColor::White, 2, 1);
+    moveOrdering.recordCutoff(second, FigureColor::White, 2, 1);
+    moveOrdering.recordCutoff(second, FigureColor::White, 2, 1);
+    moveOrdering.recordCutoff(third, FigureColor::White, 2, 1);
+    EXPECT_EQ(moveOrdering.hints(FigureColor::White, 2, std::nullopt).killers, (Killers{third, second}));
+
+    // Killers belong to their ply.
+    EXPECT_EQ(moveOrdering.hints(FigureColor::White, 1, std::nullopt).killers, Killers{});
+    EXPECT_EQ(moveOrdering.hints(FigureColor::White, 3, std::nullopt).killers, Killers{});
+}
+
+TEST(MoveOrdering, HistoryShouldDependOnColorAndGrowWithDepth)
+{
+    const auto shallow = quietMove(20, 24);
+    const auto deep = quietMove(21, 25);
+    MoveOrdering moveOrdering;
+    moveOrdering.recordCutoff(shallow, FigureColor::White, 1, 2);
+    moveOrdering.recordCutoff(shallow, FigureColor::White, 1, 2);
+    moveOrdering.recordCutoff(deep, FigureColor::White, 2, 3);
+    moveOrdering.recordCutoff(shallow, FigureColor::Black, 3, 5);
+
+    const auto& whiteHistory = *moveOrdering.hints(FigureColor::White, 4, std::nullopt).history;
+    EXPECT_EQ(whiteHistory[20][24], 8u);
+    EXPECT_EQ(whiteHistory[21][25], 9u);
+    const auto& blackHistory = *moveOrdering.hints(FigureColor::Black, 4, std::nullopt).history;
+    EXPECT_EQ(blackHistory[20][24], 25u);
+    EXPECT_EQ(blackHistory[21][25], 0u);
+}
+
+TEST(MoveOrdering, CapturesShouldNotBecomeKillers)
+{
+    const auto capture = jump(4, 13, {9});
+    MoveOrdering moveOrdering;
+    moveOrdering.recordCutoff(capture, FigureColor::White, 1, 3);
+    const auto hints = moveOrdering.hints(FigureColor::White, 1, std::nullopt);
+    EXPECT_EQ(hints.killers, Killers{});
+    EXPECT_EQ((*hints.history)[4][13], 0u);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <utility>
 
 #include "Strategy.hpp"
 struct StrategyTest : public ::testing::Test
@@ -14,9 +15,10 @@ TEST_F(StrategyTest, AlphaBetaPrunningShouldEmptyMoveWhenNoPossibleMove)
     board[0][6] = FigureState{FigureColor::White};
     GameState gameState{std::move(board)};
 
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::Black);
     const auto result = sut->getMiniMaxMove(
-        gameState, [](const GameState&, FigureColor) { return 1; }, FigureColor::Black, 15);
-    EXPECT_TRUE(result.move.empty());
+        gameState, possibleMoves, [](const GameState&, FigureColor) { return 1; }, FigureColor::Black, 15, {});
+    EXPECT_FALSE(result.has_value());
 }
 TEST_F(StrategyTest, AlphaBetaPrunningShouldEmptyMoveWhenMaxDepthIs0)
 {
@@ -26,9 +28,10 @@ TEST_F(StrategyTest, AlphaBetaPrunningShouldEmptyMoveWhenMaxDepthIs0)
     board[0][6] = FigureState{FigureColor::White};
     GameState gameState{std::move(board)};
 
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::Black);
     const auto result = sut->getMiniMaxMove(
-        gameState, [](const GameState&, FigureColor) { return 1; }, FigureColor::Black, 0);
-    EXPECT_TRUE(result.move.empty());
+        gameState, possibleMoves, [](const GameState&, FigureColor) { return 1; }, FigureColor::Black, 0, {});
+    EXPECT_FALSE(result.has_value());
 }
 
 TEST_F(StrategyTest, AlphaBetaPrunningShouldReturnAlwaysFirstMoveOfRequestingPlayer)
@@ -38,11 +41,13 @@ TEST_F(StrategyTest, AlphaBetaPrunningShouldReturnAlwaysFirstMoveOfRequestingPla
     board[7][3] = FigureState{FigureColor::Black};
     GameState gameState{std::move(board)};
 
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::White);
     for (int i = 1; i < 5; i++)
     {
         const auto result = sut->getMiniMaxMove(
-            gameState, [](const GameState&, FigureColor) { return 1; }, FigureColor::White, i);
-        const auto& move = result.move;
+            gameState, possibleMoves, [](const GameState&, FigureColor) { return 1; }, FigureColor::White, i, {});
+        ASSERT_TRUE(result.has_value());
+        const auto move = possibleMoves.at(*result).move.path();
         EXPECT_EQ(move.size(), 2);
         EXPECT_EQ(move.at(0).row, 0);
         EXPECT_EQ(move.at(0).col, 4);
@@ -76,8 +81,10 @@ TEST_F(StrategyTest, AlphaBetaPrunningShouldReturnConcreteMoveAndDoPrunning)
     board[7][3] = FigureState{FigureColor::Black};
     GameState gameState{std::move(board)};
     int callNumber = 0;
-    const auto returnedGameState = sut->getMiniMaxMove(
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::White);
+    const auto result = sut->getMiniMaxMove(
         gameState,
+        possibleMoves,
         [&](const GameState&, FigureColor player) {
             int evalValue = getExpectationsOnConcreteEvaluationAndReturnValue(callNumber, player);
             EXPECT_NE(evalValue, failureEvalValue);
@@ -85,12 +92,209 @@ TEST_F(StrategyTest, AlphaBetaPrunningShouldReturnConcreteMoveAndDoPrunning)
             return evalValue;
         },
         FigureColor::White,
-        3);
+        3,
+        {});
     EXPECT_EQ(callNumber, 5);
-    const auto& move = returnedGameState.move;
+    ASSERT_TRUE(result.has_value());
+    const auto move = possibleMoves.at(*result).move.path();
     EXPECT_EQ(move.size(), 2);
     EXPECT_EQ(move.at(0).row, 0);
     EXPECT_EQ(move.at(0).col, 4);
     EXPECT_EQ(move.at(1).row, 1);
     EXPECT_EQ(move.at(1).col, 3);
 }
+
+TEST_F(StrategyTest, AlphaBetaPrunningShouldScoreRepeatedPositionAsDrawWithoutExpandingIt)
+{
+    Board board;
+    board[0][0] = FigureState{FigureType::King, FigureColor::White};
+    board[7][7] = FigureState{FigureType::King, FigureColor::White};
+    board[0][6] = FigureState{FigureType::King, FigureColor::Black};
+    GameState gameState{std::move(board)};
+
+    bool repetitionScored = false;
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::White);
+    const auto result = sut->getMiniMaxMove(
+        gameState,
+        possibleMoves,
+        [&](const GameState&, FigureColor player) {
+            // Leaves are evaluated for the calling player only, a draw is scored from both points of view.
+            if (player == FigureColor::Black)
+            {
+                repetitionScored = true;
+            }
+            return 1;
+        },
+        FigureColor::White,
+        5,
+        {});
+    EXPECT_TRUE(result.has_value());
+    EXPECT_TRUE(repetitionScored);
+}
+
+TEST_F(StrategyTest, AlphaBetaPrunningShouldScoreRootMoveRepeatingGamePositionAsDraw)
+{
+    Board board;
+    board[0][0] = FigureState{FigureType::King, FigureColor::White};
+    board[7][7] = FigureState{FigureType::King, FigureColor::White};
+    board[0][6] = FigureState{FigureType::King, FigureColor::Black};
+    GameState gameState{std::move(board)};
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::White);
+    // A draw is scored halfway between both points of view, so here it scores below any position searched normally.
+    const auto evaluate = [](const GameState&, FigureColor player) { return player == FigureColor::White ? 1 : -1000; };
+    ASSERT_EQ(sut->getMiniMaxMove(gameState, possibleMoves, evaluate, FigureColor::White, 1, {}), MoveIndex{0});
+
+    // The first move goes back to a position the game has already been in.
+    PositionHistory gameHistory;
+    gameHistory.push(possibleMoves[0].gameState.hash(FigureColor::Black), true);
+    gameHistory.push(gameState.hash(FigureColor::White), false);
+    const auto result = sut->getMiniMaxMove(gameState, possibleMoves, evaluate, FigureColor::White, 1, gameHistory);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_NE(*result, MoveIndex{0});
+}
+
+TEST(StrategyTranspositions, ShouldChooseSameMoveWithFewerEvaluations)
+{
+    // Pawn moves are irreversible, so no repetition can make scores depend on the path to a position.
+    const GameState gameState;
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::White);
+    const auto search = [&](const Strategy& strategy, int& evaluations) {
+        return strategy.getMiniMaxMove(
+            gameState,
+            possibleMoves,
+            [&evaluations](const GameState& gameState, FigureColor player) {
+                evaluations++;
+                return static_cast<int>(gameState.hash(player) % 1000);
+            },
+            FigureColor::White,
+            6,
+            {});
+    };
+
+    int evaluationsWithoutTable = 0;
+    const auto moveWithoutTable = search(Strategy{SearchOptions{0}}, evaluationsWithoutTable);
+    int evaluationsWithTable = 0;
+    const auto moveWithTable = search(Strategy{}, evaluationsWithTable);
+    ASSERT_TRUE(moveWithoutTable.has_value());
+    EXPECT_EQ(moveWithTable, moveWithoutTable);
+    EXPECT_LT(evaluationsWithTable, evaluationsWithoutTable);
+}
+
+TEST(StrategyTranspositions, ShouldNotReuseScoresDependingOnRepetitions)
+{
+    // With kings only, the same position is reached both along lines with a draw by repetition below it and along
+    // lines without. Reusing the first score for the second changes the chosen move.
+    Board board;
+    board[7][7] = FigureState{FigureType::King, FigureColor::White};
+    board[4][4] = FigureState{FigureType::King, FigureColor::White};
+    board[6][4] = FigureState{FigureType::King, FigureColor::Black};
+    board[3][5] = FigureState{FigureType::King, FigureColor::Black};
+    const GameState gameState{std::move(board)};
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::White);
+    const auto evaluate = [](const GameState& gameState, FigureColor player) {
+        return static_cast<int>(gameState.hash(player) >> 54);
+    };
+
+    const auto withoutTable =
+        Strategy{SearchOptions{0}}.getMiniMaxMove(gameState, possibleMoves, evaluate, FigureColor::White, 7u, {});
+    const auto withTable = Strategy{}.getMiniMaxMove(gameState, possibleMoves, evaluate, FigureColor::White, 7u, {});
+    EXPECT_EQ(withTable, withoutTable);
+}
+
+struct StrategyBudgetTest : public ::testing::Test
+{
+    std::optional<MoveIndex> search(const SearchOptions& options, unsigned int maxDepth)
+    {
+        return Strategy{options}.getMiniMaxMove(
+            gameState,
+            possibleMoves,
+            [this](const GameState& gameState, FigureColor player) {
+                evaluations++;
+                return static_cast<int>(gameState.hash(player) >> 40);
+            },
+            FigureColor::White,
+            maxDepth,
+            {});
+    }
+
+    const GameState gameState;
+    const PossibleMoves possibleMoves{GameController(gameState).getPossibleMoves(FigureColor::White)};
+    int evaluations{0};
+};
+
+TEST_F(StrategyBudgetTest, ShouldCompleteFirstDepthAndStopWhenNodesBudgetIsSpent)
+{
+    SearchOptions options;
+    options.nodesBudget = 1;
+    const auto result = search(options, 30);
+    ASSERT_TRUE(result.has_value());
+    // Depth 1 evaluates every root move, depth 2 is stopped on its first node.
+    EXPECT_EQ(evaluations, static_cast<int>(possibleMoves.size()));
+}
+
+TEST_F(StrategyBudgetTest, ShouldReturnResultOfMaxDepthWhenBudgetIsNotSpent)
+{
+    const auto fixedDepthMove = search(SearchOptions{}, 5);
+    SearchOptions options;
+    options.nodesBudget = 1'000'000'000;
+    options.timeBudget = std::chrono::hours{1};
+    EXPECT_EQ(search(options, 5), fixedDepthMove);
+}
+
+TEST_F(StrategyBudgetTest, NodesBudgetShouldMakeSearchRepeatable)
+{
+    SearchOptions options;
+    options.nodesBudget = 20'000;
+    const auto firstMove = search(options, 30);
+    const auto firstEvaluations = std::exchange(evaluations, 0);
+    EXPECT_EQ(search(options, 30), firstMove);
+    EXPECT_EQ(evaluations, firstEvaluations);
+    EXPECT_LT(evaluations, 20'000);
+}
+
+TEST_F(StrategyBudgetTest, ShouldStopWhenTimeBudgetIsSpent)
+{
+    SearchOptions options;
+    options.timeBudget = std::chrono::milliseconds{20};
+    const auto startTime = std::chrono::steady_clock::now();
+    EXPECT_TRUE(search(options, 100).has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::seconds{2});
+}
+
+TEST(StrategyMoveOrdering, ShouldChooseSameMoveWithFewerNodesAndMoreFirstMoveCutoffs)
+{
+    // Pawns only, so no repetition can make scores depend on the path to a position.
+    Board board;
+    for (const auto& [row, col] : {std::pair{0, 0}, {0, 2}, {1, 1}, {1, 5}, {2, 0}, {2, 4}, {3, 3}})
+    {
+        board[row][col] = FigureState{FigureColor::White};
+    }
+    for (const auto& [row, col] : {std::pair{7, 1}, {7, 5}, {6, 2}, {6, 6}, {5, 1}, {5, 5}, {5, 7}})
+    {
+        board[row][col] = FigureState{FigureColor::Black};
+    }
+    const GameState gameState{std::move(board)};
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(FigureColor::White);
+    const auto search = [&](bool moveOrdering) {
+        SearchOptions options;
+        options.transpositionTableSize = 0;
+        options.moveOrdering = moveOrdering;
+        const auto result = Strategy{options}.getMiniMaxMove(
+            gameState,
+            possibleMoves,
+            [](const GameState& gameState, FigureColor player) {
+                return static_cast<int>(gameState.hash(player) >> 40);
+            },
+            FigureColor::White,
+            7,
+            {});
+        return std::pair{result, Strategy::lastSearchStatistics()};
+    };
+
+    const auto [unorderedMove, unordered] = search(false);
+    const auto [orderedMove, ordered] = search(true);
+    ASSERT_TRUE(unorderedMove.has_value());
+    EXPECT_EQ(orderedMove, unorderedMove);
+    EXPECT_LT(ordered.nodes, unordered.nodes);
+    EXPECT_GT(ordered.firstMoveCutoffs * unordered.cutoffs, unordered.firstMoveCutoffs * ordered.cutoffs);
+}
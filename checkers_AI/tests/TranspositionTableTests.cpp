@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "TranspositionTable.hpp"
+
+namespace
+{
+constexpr std::size_t bucketSize = 64;
+
+Move makeJump()
+{
+    auto move = Move::startingAt(9);
+    move.addLanding(18);
+    move.captured = bitboard::squareMask<DefaultRules>(13);
+    return move;
+}
+
+// Hashes falling into the same bucket of a table with the given number of buckets, but of different positions.
+std::uint64_t collidingHash(std::uint64_t index)
+{
+    return (index + 1) << 32;
+}
+} // namespace
+
+TEST(TranspositionTable, ShouldRoundSizeDownToPowerOfTwoBuckets)
+{
+    EXPECT_EQ(TranspositionTable(0).bucketsNumber(), 1u);
+    EXPECT_EQ(TranspositionTable(bucketSize).bucketsNumber(), 1u);
+    EXPECT_EQ(TranspositionTable(3 * bucketSize).bucketsNumber(), 2u);
+    EXPECT_EQ(TranspositionTable(1024 * bucketSize).bucketsNumber(), 1024u);
+    EXPECT_EQ(TranspositionTable(1024 * bucketSize, true).bucketsNumber(), 1024u);
+}
+
+TEST(TranspositionTable, ShouldReturnStoredEntry)
+{
+    TranspositionTable table(1024 * bucketSize);
+    const auto hash = 0x123456789abcdefull;
+    EXPECT_FALSE(table.probe(hash).has_value());
+
+    const auto jump = makeJump();
+    table.store(hash, 3, -25, TranspositionTable::Bound::Lower, jump);
+    const auto entry = table.probe(hash);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->score, -25);
+    EXPECT_EQ(entry->depth, 3u);
+    EXPECT_EQ(entry->bound, TranspositionTable::Bound::Lower);
+    ASSERT_TRUE(entry->bestMove.has_value());
+    EXPECT_EQ(entry->bestMove->from, jump.from);
+    EXPECT_EQ(entry->bestMove->to, jump.to);
+    EXPECT_EQ(entry->bestMove->captured, jump.captured);
+
+    EXPECT_FALSE(table.probe(hash ^ (1ull << 40)).has_value());
+}
+
+TEST(TranspositionTable, ShouldNotReturnBestMoveWhenNoneWasFound)
+{
+    TranspositionTable table(bucketSize);
+    table.store(1, 2, 7, TranspositionTable::Bound::Upper, Move{});
+    const auto entry = table.probe(1);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_FALSE(entry->bestMove.has_value());
+}
+
+TEST(TranspositionTable, ShouldKeepDeeperEntryOfSamePosition)
+{
+    TranspositionTable table(bucketSize);
+    table.store(1, 5, 10, TranspositionTable::Bound::Exact, Move{});
+    table.store(1, 2, 20, TranspositionTable::Bound::Exact, Move{});
+    EXPECT_EQ(table.probe(1)->score, 10);
+
+    table.store(1, 5, 30, TranspositionTable::Bound::Lower, Move{});
+    EXPECT_EQ(table.probe(1)->score, 30);
+    EXPECT_EQ(table.probe(1)->bound, TranspositionTable::Bound::Lower);
+}
+
+TEST(TranspositionTable, ShouldReplaceShallowestEntryOfFullBucket)
+{
+    TranspositionTable table(bucketSize);
+    for (std::uint64_t i = 0; i < TranspositionTable::entriesPerBucket; i++)
+    {
+        table.store(collidingHash(i), static_cast<unsigned int>(i + 2), 0, TranspositionTable::Bound::Exact, Move{});
+    }
+    table.store(collidingHash(9), 1, 0, TranspositionTable::Bound::Exact, Move{});
+
+    EXPECT_FALSE(table.probe(collidingHash(0)).has_value());
+    EXPECT_TRUE(table.probe(collidingHash(9)).has_value());
+    for (std::uint64_t i = 1; i < TranspositionTable::entriesPerBucket; i++)
+    {
+        EXPECT_TRUE(table.probe(collidingHash(i)).has_value());
+    }
+}
+
+TEST(TranspositionTable, EntriesOfPreviousSearchShouldBeReplacedFirst)
+{
+    TranspositionTable table(bucketSize);
+    for (std::uint64_t i = 0; i < TranspositionTable::entriesPerBucket; i++)
+    {
+        table.store(collidingHash(i), 10, 0, TranspositionTable::Bound::Exact, Move{});
+    }
+    table.newSearch();
+    EXPECT_FALSE(table.probe(collidingHash(0)).has_value());
+
+    for (std::uint64_t i = 0; i < TranspositionTable::entriesPerBucket; i++)
+    {
+        table.store(collidingHash(i + 10), 1, 0, TranspositionTable::Bound::Exact, Move{});
+    }
+    for (std::uint64_t i = 0; i < TranspositionTable::entriesPerBucket; i++)
+    {
+        EXPECT_TRUE(table.probe(collidingHash(i + 10)).has_value());
+    }
+}
+
+TEST(TranspositionTable, ShouldStayEmptyAfterGenerationsWrapAround)
+{
+    TranspositionTable table(bucketSize);
+    table.store(1, 3, 0, TranspositionTable::Bound::Exact, Move{});
+    for (auto search = 0; search < 256; search++)
+    {
+        table.newSearch();
+        EXPECT_FALSE(table.probe(1).has_value());
+    }
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "PawnState.hpp"
+#include "Rules.hpp"
+#include "Types.hpp"
+
+constexpr auto boardSize = DefaultRules::boardSize;
+constexpr auto totalPlayerFiguresNumber = DefaultRules::figuresNumber;
+
+// Only dark squares are playable. They are numbered row by row starting from Position{0, 0}, so square index is
+// row * squaresPerRow + col / 2 and bit n of a Bitboard describes square n.
+//
+// Functions below take the rules as their first template argument, which defaults to the rules of the 8x8 game.
+using Bitboard = DefaultRules::Bitboard;
+
+namespace bitboard
+{
+constexpr auto squaresPerRow = DefaultRules::squaresPerRow;
+constexpr auto squaresNumber = DefaultRules::squaresNumber;
+static_assert(squaresNumber == 32, "Bitboard has to cover every playable square");
+
+constexpr Bitboard empty = 0u;
+
+template <typename Rules = DefaultRules>
+constexpr bool isPlayable(const Position& position)
+{
+    return (position.row + position.col) % 2 == 0;
+}
+
+template <typename Rules = DefaultRules>
+constexpr int squareIndex(const Position& position)
+{
+    return position.row * Rules::squaresPerRow + position.col / 2;
+}
+
+template <typename Rules = DefaultRules>
+constexpr Position squarePosition(int square)
+{
+    const auto row = square / Rules::squaresPerRow;
+    return Position{row, (square % Rules::squaresPerRow) * 2 + row % 2};
+}
+
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard squareMask(int square)
+{
+    return typename Rules::Bitboard{1u} << square;
+}
+
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard squareMask(const Position& position)
+{
+    return isPlayable<Rules>(position) ? squareMask<Rules>(squareIndex<Rules>(position)) : 0u;
+}
+
+inline int popCount(std::uint32_t bitboard)
+{
+    return __builtin_popcount(bitboard);
+}
+
+inline int popCount(std::uint64_t bitboard)
+{
+    return __builtin_popcountll(bitboard);
+}
+
+inline int lowestSquare(std::uint32_t bitboard)
+{
+    return __builtin_ctz(bitboard);
+}
+
+inline int lowestSquare(std::uint64_t bitboard)
+{
+    return __builtin_ctzll(bitboard);
+}
+
+inline int highestSquare(std::uint32_t bitboard)
+{
+    return 31 - __builtin_clz(bitboard);
+}
+
+inline int highestSquare(std::uint64_t bitboard)
+{
+    return 63 - __builtin_clzll(bitboard);
+}
+
+template <typename Bits>
+constexpr Bits withoutLowestSquare(Bits bitboard)
+{
+    return bitboard & (bitboard - 1);
+}
+
+constexpr std::uint32_t reversedBits(std::uint32_t bits)
+{
+    bits = ((bits >> 1u) & 0x55555555u) | ((bits & 0x55555555u) << 1u);
+    bits = ((bits >> 2u) & 0x33333333u) | ((bits & 0x33333333u) << 2u);
+    bits = ((bits >> 4u) & 0x0F0F0F0Fu) | ((bits & 0x0F0F0F0Fu) << 4u);
+    bits = ((bits >> 8u) & 0x00FF00FFu) | ((bits & 0x00FF00FFu) << 8u);
+    return (bits >> 16u) | (bits << 16u);
+}
+
+constexpr std::uint64_t reversedBits(std::uint64_t bits)
+{
+    return (static_cast<std::uint64_t>(reversedBits(static_cast<std::uint32_t>(bits))) << 32u) |
+        reversedBits(static_cast<std::uint32_t>(bits >> 32u));
+}
+
+// Every playable square.
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard allSquares()
+{
+    using Bits = typename Rules::Bitboard;
+    return static_cast<Bits>(~Bits{0u} >> (8 * sizeof(Bits) - Rules::squaresNumber));
+}
+
+// Board turned by 180 degrees: square n lands on square squaresNumber - 1 - n, so it is enough to reverse the order
+// of bits.
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard rotated(typename Rules::Bitboard bitboard)
+{
+    using Bits = typename Rules::Bitboard;
+    return static_cast<Bits>(reversedBits(bitboard) >> (8 * sizeof(Bits) - Rules::squaresNumber));
+}
+
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard rowMask(int row)
+{
+    using Bits = typename Rules::Bitboard;
+    return static_cast<Bits>(((Bits{1u} << Rules::squaresPerRow) - 1) << (row * Rules::squaresPerRow));
+}
+
+// North means towards higher rows, which is the direction white pawns move in. The order of directions is the order
+// in which moves are generated.
+enum class Direction
+{
+    SouthWest,
+    SouthEast,
+    NorthWest,
+    NorthEast
+};
+constexpr std::array<Direction, 4> allDirections{
+    Direction::SouthWest, Direction::SouthEast, Direction::NorthWest, Direction::NorthEast};
+
+constexpr Direction opposite(Direction direction)
+{
+    switch (direction)
+    {
+        case Direction::SouthWest:
+            return Direction::NorthEast;
+        case Direction::SouthEast:
+            return Direction::NorthWest;
+        case Direction::NorthWest:
+            return Direction::SouthEast;
+        case Direction::NorthEast:
+            return Direction::SouthWest;
+    }
+    return direction;
+}
+
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard evenRowsMask()
+{
+    typename Rules::Bitboard mask = 0u;
+    for (auto row = 0; row < Rules::boardSize; row += 2)
+    {
+        mask |= rowMask<Rules>(row);
+    }
+    return mask;
+}
+
+// First square of every even row, which is the only one on the west edge of the board.
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard westEdgeMask()
+{
+    typename Rules::Bitboard mask = 0u;
+    for (auto row = 0; row < Rules::boardSize; row += 2)
+    {
+        mask |= squareMask<Rules>(row * Rules::squaresPerRow);
+    }
+    return mask;
+}
+
+// Last square of every odd row.
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard eastEdgeMask()
+{
+    typename Rules::Bitboard mask = 0u;
+    for (auto row = 1; row < Rules::boardSize; row += 2)
+    {
+        mask |= squareMask<Rules>((row + 1) * Rules::squaresPerRow - 1);
+    }
+    return mask;
+}
+
+constexpr Bitboard evenRows = evenRowsMask();
+constexpr Bitboard oddRows = ~evenRows;
+constexpr Bitboard westEdge = westEdgeMask();
+constexpr Bitboard eastEdge = eastEdgeMask();
+static_assert(evenRows == 0x0F0F0F0Fu && westEdge == 0x01010101u && eastEdge == 0x80808080u, "Unexpected 8x8 masks");
+
+// Moves every square one step in the given direction, dropping squares which would leave the board.
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard shift(typename Rules::Bitboard bitboard, Direction direction)
+{
+    using Bits = typename Rules::Bitboard;
+    // Moving one row up or down keeps the index within the row or moves it by one, depending on the row parity.
+    constexpr auto row = static_cast<unsigned int>(Rules::squaresPerRow);
+    constexpr auto evenRows = evenRowsMask<Rules>();
+    constexpr auto oddRows = static_cast<Bits>(allSquares<Rules>() & ~evenRows);
+    constexpr auto notWestEdge = static_cast<Bits>(~westEdgeMask<Rules>());
+    constexpr auto notEastEdge = static_cast<Bits>(~eastEdgeMask<Rules>());
+    switch (direction)
+    {
+        case Direction::SouthWest:
+            return ((bitboard & evenRows & notWestEdge) >> (row + 1)) | ((bitboard & oddRows) >> row);
+        case Direction::SouthEast:
+            return ((bitboard & evenRows) >> row) | ((bitboard & oddRows & notEastEdge) >> (row - 1));
+        case Direction::NorthWest:
+            return static_cast<Bits>(
+                (((bitboard & evenRows & notWestEdge) << (row - 1)) | ((bitboard & oddRows) << row)) &
+                allSquares<Rules>());
+        case Direction::NorthEast:
+            return static_cast<Bits>(
+                (((bitboard & evenRows) << row) | ((bitboard & oddRows & notEastEdge) << (row + 1))) &
+                allSquares<Rules>());
+    }
+    return 0u;
+}
+
+// Squares reachable by sliding from any of the origins in the given direction: free squares along the way and the
+// first occupied square which stops the slide.
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard slidingAttacks(
+    typename Rules::Bitboard origins,
+    typename Rules::Bitboard freeSquares,
+    Direction direction)
+{
+    auto attacks = shift<Rules>(origins, direction);
+    for (auto sliding = attacks & freeSquares; sliding != 0u; sliding &= freeSquares)
+    {
+        sliding = shift<Rules>(sliding, direction);
+        attacks |= sliding;
+    }
+    return attacks;
+}
+
+// North directions lead towards higher square indices.
+constexpr bool isNorthward(Direction direction)
+{
+    return direction == Direction::NorthWest || direction == Direction::NorthEast;
+}
+
+// Of the given squares, the one met first when going from outside of them in the direction.
+template <typename Bits>
+int nearestSquare(Bits bitboard, Direction direction)
+{
+    return isNorthward(direction) ? lowestSquare(bitboard) : highestSquare(bitboard);
+}
+
+// Every square from the given one to the edge of the board in each direction, the square itself excluded.
+template <typename Rules>
+using RayTable = std::array<std::array<typename Rules::Bitboard, allDirections.size()>, Rules::squaresNumber>;
+
+template <typename Rules>
+constexpr RayTable<Rules> makeRays()
+{
+    RayTable<Rules> rays{};
+    for (auto square = 0; square < Rules::squaresNumber; square++)
+    {
+        for (const auto direction : allDirections)
+        {
+            auto& ray = rays[square][static_cast<std::size_t>(direction)];
+            for (auto next = shift<Rules>(squareMask<Rules>(square), direction);
+                 next != 0u;
+                 next = shift<Rules>(next, direction))
+            {
+                ray |= next;
+            }
+        }
+    }
+    return rays;
+}
+
+template <typename Rules = DefaultRules>
+constexpr RayTable<Rules> rays = makeRays<Rules>();
+
+// Same as slidingAttacks from a single square, but looked up: the ray is cut right after its first occupied square by
+// removing the ray which starts from that square.
+template <typename Rules = DefaultRules>
+typename Rules::Bitboard rayAttacks(int square, typename Rules::Bitboard occupied, Direction direction)
+{
+    const auto index = static_cast<std::size_t>(direction);
+    const auto ray = rays<Rules>[static_cast<std::size_t>(square)][index];
+    const auto blockers = static_cast<typename Rules::Bitboard>(ray & occupied);
+    if (blockers == 0u)
+    {
+        return ray;
+    }
+    return static_cast<typename Rules::Bitboard>(
+        ray & ~rays<Rules>[static_cast<std::size_t>(nearestSquare(blockers, direction))][index]);
+}
+
+// Squares a king reaches in the direction, up to and including the first occupied one.
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard kingReach(
+    typename Rules::Bitboard origins,
+    typename Rules::Bitboard freeSquares,
+    Direction direction)
+{
+    if constexpr (Rules::flyingKings)
+    {
+        return slidingAttacks<Rules>(origins, freeSquares, direction);
+    }
+    return shift<Rules>(origins, direction);
+}
+
+// Same as kingReach from a single square.
+template <typename Rules = DefaultRules>
+typename Rules::Bitboard kingAttacks(int square, typename Rules::Bitboard occupied, Direction direction)
+{
+    if constexpr (Rules::flyingKings)
+    {
+        return rayAttacks<Rules>(square, occupied, direction);
+    }
+    return shift<Rules>(squareMask<Rules>(square), direction);
+}
+
+constexpr std::array<Direction, 2> whitePawnDirections{Direction::NorthWest, Direction::NorthEast};
+constexpr std::array<Direction, 2> blackPawnDirections{Direction::SouthWest, Direction::SouthEast};
+
+constexpr const std::array<Direction, 2>& pawnDirections(FigureColor color)
+{
+    return color == FigureColor::White ? whitePawnDirections : blackPawnDirections;
+}
+
+template <typename Rules = DefaultRules>
+constexpr typename Rules::Bitboard promotionRow(FigureColor color)
+{
+    return color == FigureColor::White ? rowMask<Rules>(Rules::boardSize - 1) : rowMask<Rules>(0);
+}
+} // namespace bitboard
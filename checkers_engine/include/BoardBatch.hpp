@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GameState.hpp"
+
+// Per-board results of BoardBatch::computeMasks, indexed like the boards of the batch.
+struct BatchMasks
+{
+    // Origins of the legal moves of a board whose jumpingFigures is empty.
+    std::vector<Bitboard> moveableFigures;
+    // Figures with any capture, not only the longest ones. These are not the legal origins, which only
+    // GameController::movablePiecesMask gives; an empty mask does tell that the side has no capture.
+    std::vector<Bitboard> jumpingFigures;
+    std::vector<std::uint32_t> figuresNumber;
+    std::vector<std::uint32_t> opponentFiguresNumber;
+};
+
+// Many positions stored as structure of arrays, so games played in lockstep can be processed together. With AVX2
+// enabled (CHECKERS_AVX2) eight boards share one register; otherwise every board is processed by scalar code.
+class BoardBatch
+{
+public:
+    static constexpr std::size_t lanesNumber = 8;
+
+    explicit BoardBatch(std::size_t boardsNumber);
+
+    std::size_t size() const;
+    void set(std::size_t board, const GameState&);
+    GameState get(std::size_t board) const;
+
+    // Figures of the given color which have a simple move, which have any capture, and figure counts of both sides.
+    // Only the longest captures of a side are legal, so the capture mask is a superset of the figures which may move.
+    void computeMasks(FigureColor, BatchMasks&) const;
+
+private:
+    std::size_t m_boardsNumber;
+    std::vector<Bitboard> m_whiteFigures;
+    std::vector<Bitboard> m_blackFigures;
+    std::vector<Bitboard> m_kings;
+};
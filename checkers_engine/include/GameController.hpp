@@ -1,32 +1,92 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 #include "GameState.hpp"
+#include "MoveBuffer.hpp"
 #include "Types.hpp"
 
-struct GameStateWithMove
+template <typename Rules>
+struct BasicGameStateWithMove
 {
-    GameState gameState;
-    Move move;
+    BasicGameState<Rules> gameState;
+    BasicMove<Rules> move;
 };
 
-class GameController
+template <typename Rules>
+using BasicMoveList = std::vector<BasicMove<Rules>>;
+template <typename Rules>
+using BasicPossibleMoves = std::vector<BasicGameStateWithMove<Rules>>;
+
+using GameStateWithMove = BasicGameStateWithMove<DefaultRules>;
+using MoveList = BasicMoveList<DefaultRules>;
+using PossibleMoves = BasicPossibleMoves<DefaultRules>;
+using MoveIndex = std::size_t;
+
+template <typename Rules>
+class BasicGameController
 {
 public:
-    explicit GameController(const GameState&);
+    using Bitboard = typename Rules::Bitboard;
+    using GameState = BasicGameState<Rules>;
+    using Move = BasicMove<Rules>;
+    using MoveBuffer = BasicMoveBuffer<Rules>;
+    using MoveList = BasicMoveList<Rules>;
+    using GameStateWithMove = BasicGameStateWithMove<Rules>;
+
+    explicit BasicGameController(const GameState&);
+
+    MoveList getMoveList(FigureColor) const;
+    void getMoveList(FigureColor, MoveBuffer&) const;
+
+    void getJumps(FigureColor, MoveBuffer&) const;
+    void getPromotions(FigureColor, MoveBuffer&) const;
+    void getQuietMoves(FigureColor, MoveBuffer&) const;
+    // The quiet move between the given squares when it is legal, checked on the bitboards without generating moves.
+    std::optional<Move> getQuietMove(FigureColor, int from, int to) const;
 
     std::vector<GameStateWithMove> getPossibleMoves(FigureColor) const;
+    std::vector<GameStateWithMove> getPossibleMoves(const MoveList&) const;
 
     GameResult gameResult(FigureColor) const;
 
+    // Queries answered from the bitboards, without building moves or resulting positions whenever the side has no
+    // capture. Otherwise jumps are still generated, because only the longest capture sequences are legal.
+    bool hasAnyMove(FigureColor) const;
+    int countMoves(FigureColor) const;
+    // Figures of the given type which are the origin of at least one legal move.
+    Bitboard movablePiecesMask(FigureColor, FigureType) const;
+    // Figures with any capture, found without generating jumps. Only the longest captures of the side are legal, so
+    // this is a superset of the figures which may capture.
+    Bitboard getJumpingFigures(FigureColor) const;
+
 private:
-    std::vector<GameStateWithMove> getAvailableJumps(const Figure&) const;
+    // Capture search state shared by the whole recursion. The board is updated in place while a chain is extended and
+    // restored when the search backtracks.
+    struct JumpSearch
+    {
+        Bitboard opponents;
+        Bitboard freeSquares;
+        Move jump;
+        FigureColor color;
+        bool isKing;
+        MoveBuffer& jumps;
+    };
+
+    Bitboard getMoveableFigures(FigureColor) const;
+
+    Figure figureAt(int square, FigureColor) const;
 
-    std::vector<GameStateWithMove> getAvailableMoves(const Figure&) const;
+    void addAvailableMoves(const Figure&, Bitboard pawnTargets, MoveBuffer&) const;
 
-    void findJump(GameState, Move, const Figure, std::vector<GameStateWithMove>&) const;
+    void findJump(JumpSearch&, int square) const;
 
     bool isKingChange(FigureState, Position) const;
 
     const GameState& m_gameState;
 };
+
+extern template class BasicGameController<BrazilianRules>;
+extern template class BasicGameController<InternationalRules>;
+
+using GameController = BasicGameController<DefaultRules>;
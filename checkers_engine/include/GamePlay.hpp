@@ -1,23 +1,42 @@
 #pragma once
 #include <functional>
 #include "GameController.hpp"
+#include "PositionHistory.hpp"
+
+template <typename Rules>
+using BasicMoveDecisionCallback = std::function<
+    MoveIndex(const BasicGameState<Rules>&, const BasicPossibleMoves<Rules>&, const PositionHistory&)>;
 
 using InitialGameState = GameState;
-using MoveDecisionCallback =
-    std::function<GameStateWithMove(const InitialGameState&, const std::vector<GameStateWithMove>&)>;
+// Returns the index of the chosen move in the given possible moves. The position history holds the positions of the
+// game so far, ending with the current one, so a strategy can avoid or seek repetitions.
+using MoveDecisionCallback = BasicMoveDecisionCallback<DefaultRules>;
 
-class GamePlay
+template <typename Rules>
+class BasicGamePlay
 {
 public:
-    GamePlay(GameState& gameState, MoveDecisionCallback whiteStrategy, MoveDecisionCallback blackStrategy);
+    using GameState = BasicGameState<Rules>;
+    using MoveDecisionCallback = BasicMoveDecisionCallback<Rules>;
+    using MoveList = BasicMoveList<Rules>;
+
+    BasicGamePlay(GameState& gameState, MoveDecisionCallback whiteStrategy, MoveDecisionCallback blackStrategy);
 
     GameResult start();
     void stopGameplay();
+    // Moves made during the last game, in order, starting with white.
+    const MoveList& playedMoves() const;
 
 private:
     bool m_gameplayInterrupted{true};
+    MoveList m_playedMoves;
 
     GameState& currentGameState;
     MoveDecisionCallback whiteStrategy;
     MoveDecisionCallback blackStrategy;
 };
+
+extern template class BasicGamePlay<BrazilianRules>;
+extern template class BasicGamePlay<InternationalRules>;
+
+using GamePlay = BasicGamePlay<DefaultRules>;
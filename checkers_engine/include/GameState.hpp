@@ -1,14 +1,17 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
+#include <iterator>
 #include <optional>
 #include <utility>
 #include <vector>
+#include "Bitboard.hpp"
+#include "Move.hpp"
 #include "PawnState.hpp"
+#include "Rules.hpp"
 #include "Types.hpp"
-
-constexpr auto boardSize = 8;
-constexpr auto totalPlayerFiguresNumber = boardSize * (boardSize - 2) / 4;
+#include "Zobrist.hpp"
 
 struct Figure
 {
@@ -16,13 +19,109 @@ struct Figure
     Position position{};
 };
 
-using Board = std::array<std::array<std::optional<FigureState>, boardSize>, boardSize>;
+// Board is kept only as a convenient way of describing positions by hand. Figures placed on non-playable squares are
+// ignored when GameState is built from it.
+template <typename Rules>
+using BasicBoard = std::array<std::array<std::optional<FigureState>, Rules::boardSize>, Rules::boardSize>;
+using Board = BasicBoard<DefaultRules>;
 using Figures = std::vector<Figure>;
-class GameState
+
+// Allocation-free view of one color's figures, iterated in ascending square order like GameState::pawns.
+template <typename Rules>
+class BasicFiguresView
+{
+public:
+    using Bitboard = typename Rules::Bitboard;
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Figure;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Figure*;
+        using reference = Figure;
+
+        Iterator(Bitboard figures, Bitboard kings, FigureColor color)
+            : m_figures(figures), m_kings(kings), m_color(color)
+        {
+        }
+
+        Figure operator*() const
+        {
+            const auto square = bitboard::lowestSquare(m_figures);
+            const auto isKing = (m_kings & bitboard::squareMask<Rules>(square)) != 0u;
+            const auto type = isKing ? FigureType::King : FigureType::Pawn;
+            return Figure{FigureState{type, m_color}, bitboard::squarePosition<Rules>(square)};
+        }
+
+        Iterator& operator++()
+        {
+            m_figures = bitboard::withoutLowestSquare(m_figures);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return m_figures == other.m_figures; }
+        bool operator!=(const Iterator& other) const { return m_figures != other.m_figures; }
+
+    private:
+        Bitboard m_figures;
+        Bitboard m_kings;
+        FigureColor m_color;
+    };
+
+    BasicFiguresView(Bitboard figures, Bitboard kings, FigureColor color)
+        : m_figures(figures), m_kings(kings), m_color(color)
+    {
+    }
+
+    Iterator begin() const { return Iterator{m_figures, m_kings, m_color}; }
+    Iterator end() const { return Iterator{0u, m_kings, m_color}; }
+
+    bool empty() const { return m_figures == 0u; }
+    int size() const { return bitboard::popCount(m_figures); }
+    int kingsNumber() const { return bitboard::popCount(m_figures & m_kings); }
+    int pawnsNumber() const { return bitboard::popCount(m_figures & ~m_kings); }
+    FigureColor color() const { return m_color; }
+
+private:
+    Bitboard m_figures;
+    Bitboard m_kings;
+    FigureColor m_color;
+};
+
+using FiguresView = BasicFiguresView<DefaultRules>;
+
+// Part of the position which cannot be recovered from Move alone when it is taken back.
+template <typename Rules>
+struct BasicUndoRecord
+{
+    typename Rules::Bitboard capturedKings{0u};
+    std::uint64_t hash{0};
+};
+
+using UndoRecord = BasicUndoRecord<DefaultRules>;
+
+template <typename Rules>
+class BasicGameState
 {
 public:
-    GameState();
-    explicit GameState(Board&& board);
+    using Bitboard = typename Rules::Bitboard;
+    using Move = BasicMove<Rules>;
+    using UndoRecord = BasicUndoRecord<Rules>;
+    using FiguresView = BasicFiguresView<Rules>;
+    using Board = BasicBoard<Rules>;
+
+    BasicGameState();
+    explicit BasicGameState(Board&& board);
+    BasicGameState(Bitboard whiteFigures, Bitboard blackFigures, Bitboard kings);
     void removePawn(const Position&);
     void movePawn(const Position&, const Position&);
     void changePawnType(const Position&, FigureType);
@@ -30,9 +129,240 @@ public:
     static bool isValid(const Position&);
     FigureState pawnAtPosition(const Position&) const;
     Figures pawns(FigureColor) const;
+    FiguresView figuresView(FigureColor) const;
+    int figuresNumber(FigureColor) const;
+    int kingsNumber(FigureColor) const;
+
+    UndoRecord makeMove(const Move&);
+    void unmakeMove(const Move&, const UndoRecord&);
+
+    Bitboard figures(FigureColor) const;
+    Bitboard kings() const;
+    Bitboard occupied() const;
+
+    // Zobrist hash of the position with the given side to move. It is kept up to date by every change of the position.
+    std::uint64_t hash(FigureColor sideToMove) const;
 
-    bool operator==(const GameState&) const;
+    // Position with colors swapped and the board turned by 180 degrees. With the other side to move it is
+    // strategically the same position.
+    BasicGameState mirrored() const;
+    // A position is canonical when its (white, black, kings) bitboards are not greater than those of its mirror.
+    // Position caches may key on the canonical form to store a position and its mirror once; the side to move has to
+    // be flipped whenever the canonical form is the mirror.
+    bool isCanonical() const;
+    // A symmetric position is its own mirror, so it is the same position whichever side is to move.
+    bool isSymmetric() const;
+    BasicGameState canonical() const;
+    // Hash of the canonical form with the matching side to move. Equal for a position and its mirror with the other
+    // side to move, and for both sides to move of a symmetric position.
+    std::uint64_t canonicalHash(FigureColor sideToMove) const;
+
+    bool operator==(const BasicGameState&) const;
 
 private:
-    Board gameState;
+    std::uint64_t figureKey(Bitboard square) const;
+    std::uint64_t calculateHash() const;
+
+    std::uint64_t m_hash{0};
+    Bitboard m_whiteFigures{0u};
+    Bitboard m_blackFigures{0u};
+    Bitboard m_kings{0u};
 };
+
+// Accessors, make/unmake and hashing run in the innermost search loops, so they are defined here where callers
+// from every library can inline them.
+namespace detail
+{
+template <typename Bitboard>
+inline void moveSquare(Bitboard& bitboard, Bitboard from, Bitboard to)
+{
+    const bool fromSet = (bitboard & from) != 0u;
+    bitboard &= ~(from | to);
+    if (fromSet)
+    {
+        bitboard |= to;
+    }
+}
+} // namespace detail
+
+template <typename Rules>
+inline void BasicGameState<Rules>::removePawn(const Position& position)
+{
+    m_hash ^= figureKey(bitboard::squareMask<Rules>(position));
+    const auto mask = static_cast<Bitboard>(~bitboard::squareMask<Rules>(position));
+    m_whiteFigures &= mask;
+    m_blackFigures &= mask;
+    m_kings &= mask;
+}
+
+template <typename Rules>
+inline void BasicGameState<Rules>::movePawn(const Position& from, const Position& to)
+{
+    const auto fromMask = bitboard::squareMask<Rules>(from);
+    const auto toMask = bitboard::squareMask<Rules>(to);
+    m_hash ^= figureKey(fromMask) ^ figureKey(toMask);
+    detail::moveSquare(m_whiteFigures, fromMask, toMask);
+    detail::moveSquare(m_blackFigures, fromMask, toMask);
+    detail::moveSquare(m_kings, fromMask, toMask);
+    m_hash ^= figureKey(toMask);
+}
+
+template <typename Rules>
+inline void BasicGameState<Rules>::changePawnType(const Position& position, FigureType type)
+{
+    const auto mask = static_cast<Bitboard>(bitboard::squareMask<Rules>(position) & occupied());
+    m_hash ^= figureKey(mask);
+    if (type == FigureType::King)
+    {
+        m_kings |= mask;
+    }
+    else
+    {
+        m_kings &= ~mask;
+    }
+    m_hash ^= figureKey(mask);
+}
+
+template <typename Rules>
+inline bool BasicGameState<Rules>::isFree(const Position& position) const
+{
+    return (occupied() & bitboard::squareMask<Rules>(position)) == 0u;
+}
+
+template <typename Rules>
+inline bool BasicGameState<Rules>::isValid(const Position& position)
+{
+    const bool rowValid = (position.row >= 0 && position.row < Rules::boardSize);
+    const bool colValid = (position.col >= 0 && position.col < Rules::boardSize);
+    return rowValid && colValid && (position.col % 2 == (position.row % 2 == 0 ? 0 : 1));
+}
+
+template <typename Rules>
+inline FigureState BasicGameState<Rules>::pawnAtPosition(const Position& position) const
+{
+    const auto mask = bitboard::squareMask<Rules>(position);
+    const auto type = (m_kings & mask) != 0u ? FigureType::King : FigureType::Pawn;
+    const auto color = (m_blackFigures & mask) != 0u ? FigureColor::Black : FigureColor::White;
+    return FigureState{type, color};
+}
+
+template <typename Rules>
+inline BasicFiguresView<Rules> BasicGameState<Rules>::figuresView(FigureColor color) const
+{
+    return FiguresView{figures(color), m_kings, color};
+}
+
+template <typename Rules>
+inline int BasicGameState<Rules>::figuresNumber(FigureColor color) const
+{
+    return bitboard::popCount(figures(color));
+}
+
+template <typename Rules>
+inline int BasicGameState<Rules>::kingsNumber(FigureColor color) const
+{
+    return bitboard::popCount(static_cast<Bitboard>(figures(color) & m_kings));
+}
+
+template <typename Rules>
+inline BasicUndoRecord<Rules> BasicGameState<Rules>::makeMove(const Move& move)
+{
+    const auto from = bitboard::squareMask<Rules>(move.from);
+    const auto to = bitboard::squareMask<Rules>(move.to);
+    const bool whiteMoves = (m_whiteFigures & from) != 0u;
+    auto& figures = whiteMoves ? m_whiteFigures : m_blackFigures;
+    auto& opponentFigures = whiteMoves ? m_blackFigures : m_whiteFigures;
+
+    const UndoRecord undoRecord{static_cast<Bitboard>(m_kings & move.captured), m_hash};
+    for (auto captured = move.captured; captured != 0u; captured = bitboard::withoutLowestSquare(captured))
+    {
+        m_hash ^= figureKey(bitboard::squareMask<Rules>(bitboard::lowestSquare(captured)));
+    }
+    m_hash ^= figureKey(from);
+    figures ^= from ^ to;
+    opponentFigures &= ~move.captured;
+    m_kings &= ~move.captured;
+    if ((m_kings & from) != 0u)
+    {
+        m_kings ^= from ^ to;
+    }
+    else if (move.promotion)
+    {
+        m_kings |= to;
+    }
+    m_hash ^= figureKey(to);
+    return undoRecord;
+}
+
+template <typename Rules>
+inline void BasicGameState<Rules>::unmakeMove(const Move& move, const UndoRecord& undoRecord)
+{
+    const auto from = bitboard::squareMask<Rules>(move.from);
+    const auto to = bitboard::squareMask<Rules>(move.to);
+    const bool whiteMoved = (m_whiteFigures & to) != 0u;
+    auto& figures = whiteMoved ? m_whiteFigures : m_blackFigures;
+    auto& opponentFigures = whiteMoved ? m_blackFigures : m_whiteFigures;
+
+    if (move.promotion)
+    {
+        m_kings &= ~to;
+    }
+    else if ((m_kings & to) != 0u)
+    {
+        m_kings ^= from ^ to;
+    }
+    figures ^= from ^ to;
+    opponentFigures |= move.captured;
+    m_kings |= undoRecord.capturedKings;
+    m_hash = undoRecord.hash;
+}
+
+template <typename Rules>
+inline typename Rules::Bitboard BasicGameState<Rules>::figures(FigureColor color) const
+{
+    return color == FigureColor::White ? m_whiteFigures : m_blackFigures;
+}
+
+template <typename Rules>
+inline typename Rules::Bitboard BasicGameState<Rules>::kings() const
+{
+    return m_kings;
+}
+
+template <typename Rules>
+inline typename Rules::Bitboard BasicGameState<Rules>::occupied() const
+{
+    return m_whiteFigures | m_blackFigures;
+}
+
+template <typename Rules>
+inline std::uint64_t BasicGameState<Rules>::hash(FigureColor sideToMove) const
+{
+    return m_hash ^ zobrist::sideToMoveKey<Rules>(sideToMove);
+}
+
+template <typename Rules>
+inline std::uint64_t BasicGameState<Rules>::figureKey(Bitboard square) const
+{
+    if ((occupied() & square) == 0u)
+    {
+        return 0u;
+    }
+    const auto color = (m_blackFigures & square) != 0u ? FigureColor::Black : FigureColor::White;
+    const auto type = (m_kings & square) != 0u ? FigureType::King : FigureType::Pawn;
+    return zobrist::figureKey<Rules>(color, type, bitboard::lowestSquare(square));
+}
+
+template <typename Rules>
+inline bool BasicGameState<Rules>::operator==(const BasicGameState& other) const
+{
+    return m_hash == other.m_hash && m_whiteFigures == other.m_whiteFigures && m_blackFigures == other.m_blackFigures &&
+        m_kings == other.m_kings;
+}
+
+extern template class BasicGameState<BrazilianRules>;
+extern template class BasicGameState<InternationalRules>;
+
+using GameState = BasicGameState<DefaultRules>;
+
+static_assert(sizeof(GameState) == sizeof(std::uint64_t) + 4 * sizeof(Bitboard), "GameState should stay compact");
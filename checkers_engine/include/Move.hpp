@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include "Bitboard.hpp"
+#include "Types.hpp"
+
+// Fixed size, trivially copyable move. Every square the moving figure lands on is packed into bitsPerLanding bits of
+// landings, so a jump capturing all opponent figures still fits. An empty move has no landings.
+template <typename Rules>
+struct BasicMove
+{
+    using Bitboard = typename Rules::Bitboard;
+
+    static constexpr auto bitsPerLanding = Rules::squaresNumber <= 32 ? 5u : 6u;
+    static constexpr auto landingMask = (1u << bitsPerLanding) - 1;
+    // Every landing of a jump captures a figure, so this holds as long as no side has more figures than at the start.
+    // Positions built by play keep to that, and the notation parsers reject any other. Sizing for every capturable
+    // square instead would not fit an 8x8 move into one word.
+    static constexpr auto maxLandingsNumber = Rules::figuresNumber;
+    static constexpr auto landingsPerWord = 64 / static_cast<int>(bitsPerLanding);
+    static constexpr auto landingWordsNumber = (maxLandingsNumber + landingsPerWord - 1) / landingsPerWord;
+
+    std::array<std::uint64_t, landingWordsNumber> landings{};
+    Bitboard captured{0u};
+    std::uint8_t from{0};
+    std::uint8_t to{0};
+    std::uint8_t landingsNumber{0};
+    bool promotion{false};
+
+    static BasicMove startingAt(int square)
+    {
+        BasicMove move;
+        move.from = static_cast<std::uint8_t>(square);
+        move.to = move.from;
+        return move;
+    }
+
+    void addLanding(int square)
+    {
+        assert(landingsNumber < maxLandingsNumber);
+        landings[wordOf(landingsNumber)] |= static_cast<std::uint64_t>(square) << bitOf(landingsNumber);
+        to = static_cast<std::uint8_t>(square);
+        landingsNumber++;
+    }
+
+    // Takes back the last landing added.
+    void removeLastLanding()
+    {
+        landingsNumber--;
+        landings[wordOf(landingsNumber)] &= ~(static_cast<std::uint64_t>(landingMask) << bitOf(landingsNumber));
+        to = static_cast<std::uint8_t>(landingsNumber == 0 ? from : landing(landingsNumber - 1));
+    }
+
+    int landing(int index) const { return static_cast<int>((landings[wordOf(index)] >> bitOf(index)) & landingMask); }
+
+    bool empty() const { return landingsNumber == 0; }
+
+    Position origin() const { return bitboard::squarePosition<Rules>(from); }
+
+    Position destination() const { return bitboard::squarePosition<Rules>(to); }
+
+    // Expands the move into every visited position, starting with the origin.
+    Path path() const
+    {
+        Path path;
+        if (empty())
+        {
+            return path;
+        }
+        path.reserve(landingsNumber + 1);
+        path.push_back(origin());
+        for (int i = 0; i < landingsNumber; i++)
+        {
+            path.push_back(bitboard::squarePosition<Rules>(landing(i)));
+        }
+        return path;
+    }
+
+    bool operator==(const BasicMove& other) const
+    {
+        return landings == other.landings && captured == other.captured && from == other.from && to == other.to &&
+            landingsNumber == other.landingsNumber && promotion == other.promotion;
+    }
+
+private:
+    static constexpr std::size_t wordOf(int index)
+    {
+        return landingWordsNumber == 1 ? 0 : static_cast<std::size_t>(index / landingsPerWord);
+    }
+
+    static constexpr unsigned int bitOf(int index)
+    {
+        const auto indexInWord = landingWordsNumber == 1 ? index : index % landingsPerWord;
+        return static_cast<unsigned int>(indexInWord) * bitsPerLanding;
+    }
+};
+
+using Move = BasicMove<DefaultRules>;
+
+static_assert(Move::landingWordsNumber == 1, "Longest 8x8 jump has to fit into one word of landings");
+static_assert(sizeof(Move) == 16, "Move should stay compact");
+static_assert(std::is_trivially_copyable_v<Move>, "Move should be trivially copyable");
+static_assert(
+    std::is_trivially_copyable_v<BasicMove<InternationalRules>>,
+    "Move should be trivially copyable for every rules");
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include "Move.hpp"
+
+// Fixed-capacity move list meant to live on the stack, so move generation never touches the heap. Quiet moves are
+// bounded by every figure being a king reaching at most two full diagonals (twelve kings and thirteen squares each on
+// the 8x8 board). Distinct capture sequences have no such small bound in arbitrary positions, so running out of room
+// throws instead of writing past the buffer.
+template <typename Rules>
+class BasicMoveBuffer
+{
+public:
+    using Move = BasicMove<Rules>;
+
+    static constexpr std::size_t capacity = 8 * Rules::squaresNumber;
+    static_assert(
+        capacity >= Rules::figuresNumber * 2 * (Rules::boardSize - 1),
+        "Buffer has to hold quiet moves of every king");
+
+    using iterator = Move*;
+    using const_iterator = const Move*;
+
+    BasicMoveBuffer() {} // NOLINT
+    BasicMoveBuffer(const BasicMoveBuffer&) = delete;
+    BasicMoveBuffer& operator=(const BasicMoveBuffer&) = delete;
+
+    void push_back(const Move& move)
+    {
+        if (m_size == capacity)
+        {
+            throw std::length_error("Move buffer capacity exceeded");
+        }
+        m_slots[m_size++].move = move;
+    }
+
+    void erase(iterator first, iterator last)
+    {
+        const auto newEnd = std::copy(last, end(), first);
+        m_size = static_cast<std::size_t>(newEnd - begin());
+    }
+
+    void clear() { m_size = 0; }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    Move& operator[](std::size_t index) { return m_slots[index].move; }
+    const Move& operator[](std::size_t index) const { return m_slots[index].move; }
+
+    iterator begin() { return &m_slots[0].move; }
+    iterator end() { return begin() + m_size; }
+    const_iterator begin() const { return &m_slots[0].move; }
+    const_iterator end() const { return begin() + m_size; }
+
+private:
+    union Slot
+    {
+        Slot() {} // NOLINT
+        Move move;
+    };
+
+    static_assert(sizeof(Slot) == sizeof(Move), "Slots have to be laid out like an array of moves");
+
+    std::array<Slot, capacity> m_slots;
+    std::size_t m_size{0};
+};
+
+using MoveBuffer = BasicMoveBuffer<DefaultRules>;
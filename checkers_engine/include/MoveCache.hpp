@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include "GameController.hpp"
+
+// Quiet move targets of every figure of a position, kept up to date across makeMove and unmakeMove. A move changes the
+// occupancy of its origin, destination and captured squares only, so just the figures which see one of those squares
+// along a diagonal are marked stale, and they are recomputed on the next getMoveList. Captures are mandatory and depend
+// on whole sequences, so they are still generated from scratch whenever the side to move has one.
+template <typename Rules>
+class BasicMoveCache
+{
+public:
+    using Bitboard = typename Rules::Bitboard;
+    using GameState = BasicGameState<Rules>;
+    using Move = BasicMove<Rules>;
+    using MoveBuffer = BasicMoveBuffer<Rules>;
+
+    explicit BasicMoveCache(const GameState&);
+
+    // Has to be called after the attached position made or took back the move.
+    void update(const Move&);
+
+    // Fills moveBuffer with the same moves, in the same order, as GameController::getMoveList.
+    void getMoveList(FigureColor, MoveBuffer&);
+
+private:
+    void refresh(Bitboard figures);
+
+    const GameState& m_gameState;
+    std::array<Bitboard, Rules::squaresNumber> m_targets{};
+    Bitboard m_staleFigures{0u};
+};
+
+extern template class BasicMoveCache<BrazilianRules>;
+extern template class BasicMoveCache<InternationalRules>;
+
+using MoveCache = BasicMoveCache<DefaultRules>;
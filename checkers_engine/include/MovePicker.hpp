@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include "GameController.hpp"
+
+// Cutoff scores of quiet moves by origin and destination square.
+using MoveHistory = std::array<std::array<std::uint32_t, DefaultRules::squaresNumber>, DefaultRules::squaresNumber>;
+
+// What a search already knows about the moves of a position. Moves are told apart by their origin, destination and
+// captured figures only, so a move taken from the transposition table is enough.
+struct MoveHints
+{
+    std::optional<Move> hashMove;
+    std::array<std::optional<Move>, 2> killers;
+    // Read whenever a stage is generated, so cutoffs recorded meanwhile already count. It has to outlive the picker.
+    const MoveHistory* history{nullptr};
+};
+
+// Yields legal moves one at a time, generating a stage only when the previous one is exhausted:
+// - the hash move, when it is a legal quiet move, before anything is generated,
+// - captures by their history score, with the hash move first (they are mandatory, so nothing else follows them),
+// - killer moves which are legal here,
+// - promotions and then the remaining quiet moves, both by their history score.
+// Without hints moves come in the order of GameController::getMoveList, except that promotions go first.
+// The game state may be changed between calls as long as it is restored before the next one.
+class MovePicker
+{
+public:
+    MovePicker(const GameState&, FigureColor, const MoveHints& = {});
+
+    std::optional<Move> nextMove();
+
+    static bool isSameMove(const Move&, const Move&);
+
+private:
+    enum class Stage
+    {
+        HashMove,
+        Captures,
+        Killers,
+        Promotions,
+        QuietMoves,
+        Done
+    };
+
+    void generateNextStage();
+    void pickHashMove();
+    void pickKillers();
+    void removePickedMoves();
+    void sortByHistory();
+    bool wasPicked(const Move&) const;
+
+    const GameController m_gameController;
+    const FigureColor m_color;
+    const MoveHints m_hints;
+    Stage m_stage{Stage::HashMove};
+    MoveBuffer m_moves;
+    std::size_t m_nextMove{0};
+    // Moves yielded ahead of their stage, which are skipped when the stage is generated.
+    std::array<Move, 3> m_pickedMoves;
+    std::size_t m_pickedMovesNumber{0};
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "GameController.hpp"
+
+struct PerftOptions
+{
+    unsigned int threadsNumber{1};
+    // Reuses the leaf count of a position reached again with the same number of plies left. Counts stay the same.
+    bool hashTranspositions{false};
+    // Counts kept by every counting thread. An entry takes about 64 bytes, so the default stays under 256 MiB per
+    // thread. Once full, further positions are counted without being kept.
+    std::size_t hashEntriesLimit{4u * 1024u * 1024u};
+};
+
+class Perft
+{
+public:
+    explicit Perft(PerftOptions options = {});
+
+    std::uint64_t countNodes(const GameState&, FigureColor sideToMove, int depth) const;
+
+private:
+    std::uint64_t countNodesInParallel(const GameState&, FigureColor sideToMove, int depth) const;
+
+    const PerftOptions m_options;
+};
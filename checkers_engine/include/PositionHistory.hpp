@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "GameState.hpp"
+
+// Hashes of positions reached so far, used to detect repetitions. Only positions since the last irreversible move
+// (a capture or a pawn move) can repeat, so lookups stop at the most recent irreversible entry.
+class PositionHistory
+{
+public:
+    void push(std::uint64_t hash, bool irreversible);
+    void pop();
+    void clear();
+    bool empty() const { return m_entries.empty(); }
+
+    // Number of times the position was reached since the last irreversible move.
+    int occurrences(std::uint64_t hash) const;
+
+    template <typename Rules>
+    static bool isIrreversible(const BasicGameState<Rules>& gameStateBeforeMove, const BasicMove<Rules>& move)
+    {
+        const auto isKingMove = (gameStateBeforeMove.kings() & bitboard::squareMask<Rules>(move.from)) != 0u;
+        return move.captured != 0u || !isKingMove;
+    }
+
+private:
+    struct Entry
+    {
+        std::uint64_t hash;
+        bool irreversible;
+    };
+
+    std::vector<Entry> m_entries;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "GameController.hpp"
+
+// Binary and text forms of positions and moves. Text forms follow PDN: squares are numbered 1 to 32 from black's
+// back row, so white figures of the initial position stand on squares 21 to 32. Parsers do not allocate and return
+// std::nullopt on malformed input instead of throwing, so they can be used on large position suites.
+namespace notation
+{
+// White figures, black figures and kings bitboards, four little-endian bytes each.
+using PackedPosition = std::array<std::uint8_t, 12>;
+
+struct FenPosition
+{
+    GameState gameState;
+    FigureColor sideToMove;
+};
+
+int pdnSquare(int square);
+int squareFromPdn(int pdnSquare);
+
+PackedPosition pack(const GameState&);
+// Fails when colors overlap, a king is marked on an empty square or a side has more figures than at the start.
+std::optional<GameState> unpack(const PackedPosition&);
+
+// For example "W:W21,22,K30:B1,2,3", side to move first, then figures of both colors with kings marked by K.
+std::string toFen(const GameState&, FigureColor sideToMove);
+// Accepts both color sections in any order, ranges like "B1-12" and a trailing dot. Rejects the same positions as
+// unpack.
+std::optional<FenPosition> fromFen(std::string_view fen);
+
+// Squares the move lands on separated with '-' for a simple move or 'x' for a jump, for example "9x18x27".
+std::string toPdn(const Move&);
+// Finds the legal move written in PDN. Jumps may be written with the origin and the destination only, as long as
+// that is unambiguous.
+std::optional<Move> moveFromPdn(std::string_view pdn, const MoveList& legalMoves);
+} // namespace notation
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// Compile-time description of a draughts variant. The engine is instantiated once per rules, so rule flags are
+// resolved while compiling instead of being tested in the move generation loops.
+template <int BoardSize, bool FlyingKings, bool MenCaptureBackward>
+struct Rules
+{
+    static_assert(BoardSize % 2 == 0 && BoardSize >= 6, "Board needs an even number of rows and some space to play");
+
+    static constexpr int boardSize = BoardSize;
+    // Kings move and capture along whole diagonals instead of one square at a time.
+    static constexpr bool flyingKings = FlyingKings;
+    static constexpr bool menCaptureBackward = MenCaptureBackward;
+
+    static constexpr int squaresPerRow = boardSize / 2;
+    static constexpr int squaresNumber = boardSize * squaresPerRow;
+    // Two middle rows are empty in the initial position.
+    static constexpr int rowsWithFigures = (boardSize - 2) / 2;
+    static constexpr int figuresNumber = rowsWithFigures * squaresPerRow;
+
+    using Bitboard = std::conditional_t<(squaresNumber <= 32), std::uint32_t, std::uint64_t>;
+    static_assert(squaresNumber <= 64, "Every playable square needs its bit");
+};
+
+// International rules on the 8x8 board, the game played by the AI.
+using BrazilianRules = Rules<8, true, true>;
+// International draughts on the 10x10 board.
+using InternationalRules = Rules<10, true, true>;
+using DefaultRules = BrazilianRules;
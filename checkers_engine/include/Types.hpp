@@ -17,7 +17,7 @@ struct Position
     bool operator==(const Position& other) const { return row == other.row && col == other.col; }
 };
 
-using Move = std::vector<Position>;
+using Path = std::vector<Position>;
 
 enum class GameResult
 {
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Bitboard.hpp"
+#include "PawnState.hpp"
+
+// Random keys for hashing positions. A position hash is the xor of keys of every figure on its square, plus
+// blackToMove when black is the side to move. Keys are generated at compile time, so hashes are stable between runs.
+//
+// Only white keys are random. A black figure uses the key of the white figure on the rotated square with its halves
+// swapped, so the hash of a position mirrored by GameState::mirrored is the figures hash with swapped halves.
+namespace zobrist
+{
+constexpr auto figureKindsNumber = 4;
+
+template <typename Rules>
+struct Keys
+{
+    std::array<std::array<std::uint64_t, Rules::squaresNumber>, figureKindsNumber> figures{};
+    std::uint64_t blackToMove{0};
+};
+
+constexpr std::uint64_t splitMix64(std::uint64_t& state)
+{
+    state += 0x9E3779B97F4A7C15ull;
+    auto result = state;
+    result = (result ^ (result >> 30u)) * 0xBF58476D1CE4E5B9ull;
+    result = (result ^ (result >> 27u)) * 0x94D049BB133111EBull;
+    return result ^ (result >> 31u);
+}
+
+constexpr std::uint64_t mirroredHash(std::uint64_t hash)
+{
+    return (hash >> 32u) | (hash << 32u);
+}
+
+constexpr int figureKind(FigureColor color, FigureType type)
+{
+    return (color == FigureColor::Black ? 2 : 0) + (type == FigureType::King ? 1 : 0);
+}
+
+template <typename Rules>
+constexpr Keys<Rules> generateKeys()
+{
+    std::uint64_t state = 0x6765'6E65'7469'6321ull;
+    Keys<Rules> keys;
+    for (const auto type : {FigureType::Pawn, FigureType::King})
+    {
+        for (auto& key : keys.figures[figureKind(FigureColor::White, type)])
+        {
+            key = splitMix64(state);
+        }
+    }
+    for (const auto type : {FigureType::Pawn, FigureType::King})
+    {
+        for (auto square = 0; square < Rules::squaresNumber; square++)
+        {
+            keys.figures[figureKind(FigureColor::Black, type)][square] =
+                mirroredHash(keys.figures[figureKind(FigureColor::White, type)][Rules::squaresNumber - 1 - square]);
+        }
+    }
+    keys.blackToMove = splitMix64(state);
+    return keys;
+}
+
+template <typename Rules>
+constexpr Keys<Rules> keys = generateKeys<Rules>();
+
+template <typename Rules = DefaultRules>
+constexpr std::uint64_t figureKey(FigureColor color, FigureType type, int square)
+{
+    return keys<Rules>.figures[figureKind(color, type)][square];
+}
+
+template <typename Rules = DefaultRules>
+constexpr std::uint64_t sideToMoveKey(FigureColor sideToMove)
+{
+    return sideToMove == FigureColor::Black ? keys<Rules>.blackToMove : 0u;
+}
+} // namespace zobrist
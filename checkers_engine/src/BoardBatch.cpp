@@ -0,0 +1,224 @@
+#include "BoardBatch.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+std::size_t paddedSize(std::size_t boardsNumber)
+{
+    return (boardsNumber + BoardBatch::lanesNumber - 1) / BoardBatch::lanesNumber * BoardBatch::lanesNumber;
+}
+
+// The algorithms below are written once for any type of lanes: a single Bitboard for the scalar path or eight of them
+// in an AVX2 register. They mirror GameController::getJumpingFigures and GameController::getMoveableFigures.
+template <typename Lanes>
+Lanes splat(Bitboard bitboard);
+
+#ifdef __AVX2__
+struct Lanes8
+{
+    __m256i value;
+};
+
+template <>
+Lanes8 splat<Lanes8>(Bitboard bitboard)
+{
+    return {_mm256_set1_epi32(static_cast<int>(bitboard))};
+}
+
+inline Lanes8 operator&(Lanes8 first, Lanes8 second)
+{
+    return {_mm256_and_si256(first.value, second.value)};
+}
+
+inline Lanes8 operator|(Lanes8 first, Lanes8 second)
+{
+    return {_mm256_or_si256(first.value, second.value)};
+}
+
+inline Lanes8 operator~(Lanes8 lanes)
+{
+    return {_mm256_xor_si256(lanes.value, _mm256_set1_epi32(-1))};
+}
+
+inline Lanes8 operator<<(Lanes8 lanes, unsigned int bits)
+{
+    return {_mm256_slli_epi32(lanes.value, static_cast<int>(bits))};
+}
+
+inline Lanes8 operator>>(Lanes8 lanes, unsigned int bits)
+{
+    return {_mm256_srli_epi32(lanes.value, static_cast<int>(bits))};
+}
+
+// Counts bits of every nibble with a lookup table, then sums the nibble counts within each 32-bit lane.
+inline Lanes8 popCounts(Lanes8 lanes)
+{
+    const auto lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const auto lowNibbles = _mm256_set1_epi8(0x0F);
+    const auto low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(lanes.value, lowNibbles));
+    const auto high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi32(lanes.value, 4), lowNibbles));
+    auto counts = _mm256_add_epi8(low, high);
+    counts = _mm256_add_epi32(counts, _mm256_srli_epi32(counts, 8));
+    counts = _mm256_add_epi32(counts, _mm256_srli_epi32(counts, 16));
+    return {_mm256_and_si256(counts, _mm256_set1_epi32(0x3F))};
+}
+
+inline Lanes8 load(const Bitboard* bitboards)
+{
+    return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bitboards))}; // NOLINT
+}
+
+inline void store(std::uint32_t* destination, Lanes8 lanes)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), lanes.value); // NOLINT
+}
+#else
+template <>
+Bitboard splat<Bitboard>(Bitboard bitboard)
+{
+    return bitboard;
+}
+
+inline std::uint32_t popCounts(Bitboard bitboard)
+{
+    return static_cast<std::uint32_t>(bitboard::popCount(bitboard));
+}
+#endif
+
+template <typename Lanes>
+Lanes shift(Lanes lanes, bitboard::Direction direction)
+{
+    const auto evenRows = splat<Lanes>(bitboard::evenRows);
+    const auto oddRows = splat<Lanes>(bitboard::oddRows);
+    switch (direction)
+    {
+        case bitboard::Direction::SouthWest:
+            return ((lanes & evenRows & splat<Lanes>(~bitboard::westEdge)) >> 5u) | ((lanes & oddRows) >> 4u);
+        case bitboard::Direction::SouthEast:
+            return ((lanes & evenRows) >> 4u) | ((lanes & oddRows & splat<Lanes>(~bitboard::eastEdge)) >> 3u);
+        case bitboard::Direction::NorthWest:
+            return ((lanes & evenRows & splat<Lanes>(~bitboard::westEdge)) << 3u) | ((lanes & oddRows) << 4u);
+        case bitboard::Direction::NorthEast:
+            return ((lanes & evenRows) << 4u) | ((lanes & oddRows & splat<Lanes>(~bitboard::eastEdge)) << 5u);
+    }
+    return splat<Lanes>(bitboard::empty);
+}
+
+// Same as bitboard::slidingAttacks, but with a fixed number of steps so all lanes stay in lockstep.
+template <typename Lanes>
+Lanes slidingAttacks(Lanes origins, Lanes freeSquares, bitboard::Direction direction)
+{
+    auto attacks = shift(origins, direction);
+    auto sliding = attacks & freeSquares;
+    for (auto step = 1; step < boardSize - 1; step++)
+    {
+        sliding = shift(sliding, direction);
+        attacks = attacks | sliding;
+        sliding = sliding & freeSquares;
+    }
+    return attacks;
+}
+
+template <typename Lanes>
+void computeLanes(
+    FigureColor color,
+    Lanes figures,
+    Lanes opponents,
+    Lanes kings,
+    Lanes& moveableFigures,
+    Lanes& jumpingFigures)
+{
+    const auto ownKings = figures & kings;
+    const auto pawns = figures & ~kings;
+    const auto freeSquares = ~(figures | opponents);
+
+    jumpingFigures = splat<Lanes>(bitboard::empty);
+    moveableFigures = splat<Lanes>(bitboard::empty);
+    for (const auto direction : bitboard::allDirections)
+    {
+        const auto backwards = bitboard::opposite(direction);
+        const auto beatable = opponents & shift(freeSquares, backwards);
+        jumpingFigures = jumpingFigures | (shift(beatable, backwards) & pawns);
+        jumpingFigures = jumpingFigures | (slidingAttacks(beatable, freeSquares, backwards) & ownKings);
+
+        const auto pawnDirection = color == FigureColor::White
+            ? direction == bitboard::Direction::NorthWest || direction == bitboard::Direction::NorthEast
+            : direction == bitboard::Direction::SouthWest || direction == bitboard::Direction::SouthEast;
+        const auto movers = pawnDirection ? figures : ownKings;
+        moveableFigures = moveableFigures | (shift(freeSquares, backwards) & movers);
+    }
+}
+} // namespace
+
+BoardBatch::BoardBatch(std::size_t boardsNumber)
+    : m_boardsNumber(boardsNumber)
+    , m_whiteFigures(paddedSize(boardsNumber), bitboard::empty)
+    , m_blackFigures(paddedSize(boardsNumber), bitboard::empty)
+    , m_kings(paddedSize(boardsNumber), bitboard::empty)
+{
+}
+
+std::size_t BoardBatch::size() const
+{
+    return m_boardsNumber;
+}
+
+void BoardBatch::set(std::size_t board, const GameState& gameState)
+{
+    m_whiteFigures.at(board) = gameState.figures(FigureColor::White);
+    m_blackFigures.at(board) = gameState.figures(FigureColor::Black);
+    m_kings.at(board) = gameState.kings();
+}
+
+GameState BoardBatch::get(std::size_t board) const
+{
+    return GameState{m_whiteFigures.at(board), m_blackFigures.at(board), m_kings.at(board)};
+}
+
+void BoardBatch::computeMasks(FigureColor color, BatchMasks& masks) const
+{
+    // The vector path writes whole registers, so outputs are padded like the batch and trimmed at the end.
+    const auto size = m_whiteFigures.size();
+    masks.moveableFigures.resize(size);
+    masks.jumpingFigures.resize(size);
+    masks.figuresNumber.resize(size);
+    masks.opponentFiguresNumber.resize(size);
+    const auto& figures = color == FigureColor::White ? m_whiteFigures : m_blackFigures;
+    const auto& opponents = color == FigureColor::White ? m_blackFigures : m_whiteFigures;
+
+#ifdef __AVX2__
+    for (std::size_t board = 0; board < size; board += lanesNumber)
+    {
+        const auto figureLanes = load(&figures[board]);
+        const auto opponentLanes = load(&opponents[board]);
+        Lanes8 moveableFigures{};
+        Lanes8 jumpingFigures{};
+        computeLanes(color, figureLanes, opponentLanes, load(&m_kings[board]), moveableFigures, jumpingFigures);
+        store(&masks.moveableFigures[board], moveableFigures);
+        store(&masks.jumpingFigures[board], jumpingFigures);
+        store(&masks.figuresNumber[board], popCounts(figureLanes));
+        store(&masks.opponentFiguresNumber[board], popCounts(opponentLanes));
+    }
+#else
+    for (std::size_t board = 0; board < m_boardsNumber; board++)
+    {
+        computeLanes(
+            color,
+            figures[board],
+            opponents[board],
+            m_kings[board],
+            masks.moveableFigures[board],
+            masks.jumpingFigures[board]);
+        masks.figuresNumber[board] = popCounts(figures[board]);
+        masks.opponentFiguresNumber[board] = popCounts(opponents[board]);
+    }
+#endif
+    masks.moveableFigures.resize(m_boardsNumber);
+    masks.jumpingFigures.resize(m_boardsNumber);
+    masks.figuresNumber.resize(m_boardsNumber);
+    masks.opponentFiguresNumber.resize(m_boardsNumber);
+}
@@ -1,55 +1,164 @@
 #include "GameController.hpp"
 
 #include <algorithm>
-#include <iostream>
 
 namespace
 {
-inline bool isInBoard(Position position)
+template <typename Rules>
+constexpr bool isPawnCaptureDirection(FigureColor color, bitboard::Direction direction)
 {
-    return position.col >= 0 && position.col < boardSize && position.row >= 0 && position.row < boardSize;
+    if constexpr (Rules::menCaptureBackward)
+    {
+        return true;
+    }
+    const auto& directions = bitboard::pawnDirections(color);
+    return direction == directions[0] || direction == directions[1];
 }
 } // namespace
 
-GameController::GameController(const GameState& gameState) : m_gameState(gameState) {}
+template <typename Rules>
+BasicGameController<Rules>::BasicGameController(const GameState& gameState) : m_gameState(gameState)
+{
+}
+
+template <typename Rules>
+BasicMoveList<Rules> BasicGameController<Rules>::getMoveList(FigureColor color) const
+{
+    MoveBuffer moveBuffer;
+    getMoveList(color, moveBuffer);
+    return MoveList(moveBuffer.begin(), moveBuffer.end());
+}
+
+template <typename Rules>
+void BasicGameController<Rules>::getMoveList(FigureColor color, MoveBuffer& moveBuffer) const
+{
+    getJumps(color, moveBuffer);
+    if (!moveBuffer.empty())
+    {
+        return;
+    }
+
+    for (auto figures = getMoveableFigures(color); figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        addAvailableMoves(
+            figureAt(bitboard::lowestSquare(figures), color), bitboard::allSquares<Rules>(), moveBuffer);
+    }
+}
+
+template <typename Rules>
+void BasicGameController<Rules>::getJumps(FigureColor color, MoveBuffer& moveBuffer) const
+{
+    moveBuffer.clear();
+    // The longest capture is mandatory for the whole side, so moveBuffer only ever holds chains of the longest length
+    // found so far.
+    JumpSearch search{
+        m_gameState.figures(FigureState::flipColor(color)),
+        static_cast<Bitboard>(~m_gameState.occupied()),
+        Move{},
+        color,
+        false,
+        moveBuffer};
+    for (auto figures = getJumpingFigures(color); figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        const auto square = bitboard::lowestSquare(figures);
+        search.isKing = (m_gameState.kings() & bitboard::squareMask<Rules>(square)) != 0u;
+        search.jump = Move::startingAt(square);
+        findJump(search, square);
+    }
+}
 
-std::vector<GameStateWithMove> GameController::getPossibleMoves(FigureColor color) const
+template <typename Rules>
+void BasicGameController<Rules>::getPromotions(FigureColor color, MoveBuffer& moveBuffer) const
 {
-    std::vector<GameStateWithMove> jumps;
-    std::vector<GameStateWithMove> moves;
+    moveBuffer.clear();
+    const auto pawns = static_cast<Bitboard>(m_gameState.figures(color) & ~m_gameState.kings());
+    const auto freePromotionSquares =
+        static_cast<Bitboard>(~m_gameState.occupied() & bitboard::promotionRow<Rules>(color));
+    Bitboard promotingPawns = 0u;
+    for (const auto direction : bitboard::pawnDirections(color))
+    {
+        promotingPawns |= bitboard::shift<Rules>(freePromotionSquares, bitboard::opposite(direction)) & pawns;
+    }
+    for (auto figures = promotingPawns; figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        addAvailableMoves(
+            figureAt(bitboard::lowestSquare(figures), color), bitboard::promotionRow<Rules>(color), moveBuffer);
+    }
+}
 
-    const auto& pawns = m_gameState.pawns(color);
+template <typename Rules>
+void BasicGameController<Rules>::getQuietMoves(FigureColor color, MoveBuffer& moveBuffer) const
+{
+    moveBuffer.clear();
+    const auto pawnTargets = static_cast<Bitboard>(~bitboard::promotionRow<Rules>(color));
+    for (auto figures = getMoveableFigures(color); figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        addAvailableMoves(figureAt(bitboard::lowestSquare(figures), color), pawnTargets, moveBuffer);
+    }
+}
 
-    bool foundAnyJump = false;
-    for (const auto& pawn : pawns)
+template <typename Rules>
+std::optional<BasicMove<Rules>> BasicGameController<Rules>::getQuietMove(FigureColor color, int from, int to) const
+{
+    const auto origin = bitboard::squareMask<Rules>(from);
+    const auto occupied = m_gameState.occupied();
+    if ((m_gameState.figures(color) & origin) == 0u || getJumpingFigures(color) != 0u)
     {
-        const auto pawnJumps = getAvailableJumps(pawn);
-        jumps.insert(jumps.end(), pawnJumps.begin(), pawnJumps.end());
-        if (!foundAnyJump)
+        return std::nullopt;
+    }
+
+    const auto figure = figureAt(from, color);
+    Bitboard targets = 0u;
+    if (figure.state.type != FigureType::King)
+    {
+        for (const auto direction : bitboard::pawnDirections(color))
         {
-            if (jumps.empty())
-            {
-                const auto pawnMoves = getAvailableMoves(pawn);
-                moves.insert(moves.end(), pawnMoves.begin(), pawnMoves.end());
-            }
-            else
-            {
-                foundAnyJump = true;
-            }
+            targets |= bitboard::shift<Rules>(origin, direction);
         }
     }
-
-    if (foundAnyJump)
+    else
     {
-        return jumps;
+        for (const auto direction : bitboard::allDirections)
+        {
+            targets |= bitboard::kingAttacks<Rules>(from, occupied, direction);
+        }
+    }
+    if ((targets & ~occupied & bitboard::squareMask<Rules>(to)) == 0u)
+    {
+        return std::nullopt;
     }
 
-    return moves;
+    auto move = Move::startingAt(from);
+    move.addLanding(to);
+    move.promotion = isKingChange(figure.state, bitboard::squarePosition<Rules>(to));
+    return move;
 }
 
-GameResult GameController::gameResult(FigureColor color) const
+template <typename Rules>
+std::vector<BasicGameStateWithMove<Rules>> BasicGameController<Rules>::getPossibleMoves(FigureColor color) const
 {
-    if (getPossibleMoves(color).empty())
+    return getPossibleMoves(getMoveList(color));
+}
+
+template <typename Rules>
+std::vector<BasicGameStateWithMove<Rules>> BasicGameController<Rules>::getPossibleMoves(
+    const MoveList& moveList) const
+{
+    std::vector<GameStateWithMove> possibleMoves;
+    possibleMoves.reserve(moveList.size());
+    for (const auto& move : moveList)
+    {
+        auto gameState = m_gameState;
+        gameState.makeMove(move);
+        possibleMoves.push_back({gameState, move});
+    }
+    return possibleMoves;
+}
+
+template <typename Rules>
+GameResult BasicGameController<Rules>::gameResult(FigureColor color) const
+{
+    if (!hasAnyMove(color))
     {
         return color == FigureColor::White ? GameResult::BlackWin : GameResult::WhiteWin;
     }
@@ -57,201 +166,265 @@ GameResult GameController::gameResult(FigureColor color) const
     return GameResult::GameOn;
 }
 
-std::vector<GameStateWithMove> GameController::getAvailableJumps(const Figure& pawn) const
+template <typename Rules>
+bool BasicGameController<Rules>::hasAnyMove(FigureColor color) const
+{
+    return getJumpingFigures(color) != 0u || getMoveableFigures(color) != 0u;
+}
+
+template <typename Rules>
+int BasicGameController<Rules>::countMoves(FigureColor color) const
 {
-    std::vector<GameStateWithMove> jumps;
-    findJump(m_gameState, Move{}, pawn, jumps);
-    if (jumps.empty())
+    if (getJumpingFigures(color) != 0u)
     {
-        return jumps;
+        MoveBuffer moveBuffer;
+        getJumps(color, moveBuffer);
+        return static_cast<int>(moveBuffer.size());
     }
-    std::sort(jumps.begin(), jumps.end(), [](const auto& first, const auto& second) {
-        return first.move.size() < second.move.size();
-    });
-    const auto longestJumpSize = jumps.back().move.size();
-    const auto beginOfLongestJumps =
-        std::lower_bound(jumps.cbegin(), jumps.cend(), longestJumpSize, [](const auto& first, const auto& second) {
-            return first.move.size() < second;
-        });
-
-    return {beginOfLongestJumps, jumps.cend()};
+
+    const auto figures = m_gameState.figures(color);
+    const auto kings = static_cast<Bitboard>(figures & m_gameState.kings());
+    const auto pawns = static_cast<Bitboard>(figures & ~kings);
+    const auto occupied = m_gameState.occupied();
+    const auto freeSquares = static_cast<Bitboard>(~occupied);
+
+    // Shifting is one-to-one, so every pawn target found in a direction stands for exactly one move.
+    auto movesNumber = 0;
+    for (const auto direction : bitboard::pawnDirections(color))
+    {
+        movesNumber +=
+            bitboard::popCount(static_cast<Bitboard>(bitboard::shift<Rules>(pawns, direction) & freeSquares));
+    }
+    for (auto figures = kings; figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        const auto square = bitboard::lowestSquare(figures);
+        for (const auto direction : bitboard::allDirections)
+        {
+            const auto targets = bitboard::kingAttacks<Rules>(square, occupied, direction) & freeSquares;
+            movesNumber += bitboard::popCount(static_cast<Bitboard>(targets));
+        }
+    }
+    return movesNumber;
 }
 
-void GameController::findJump(
-    GameState gameState,
-    Move jump,
-    const Figure jumpingPawn,
-    std::vector<GameStateWithMove>& allJumps) const
+template <typename Rules>
+typename Rules::Bitboard BasicGameController<Rules>::movablePiecesMask(FigureColor color, FigureType type) const
 {
-    jump.push_back(jumpingPawn.position);
-    bool foundJump{false};
-    if (jumpingPawn.state.type != FigureType::King)
+    auto movingFigures = getJumpingFigures(color);
+    if (movingFigures != 0u)
     {
-        constexpr auto pawnBeatOverOponent = 2;
-        for (const auto rowJump : {-pawnBeatOverOponent, pawnBeatOverOponent})
+        MoveBuffer moveBuffer;
+        getJumps(color, moveBuffer);
+        movingFigures = 0u;
+        for (const auto& jump : moveBuffer)
         {
-            for (const auto colJump : {-pawnBeatOverOponent, pawnBeatOverOponent})
-            {
-                const auto newPosition =
-                    Position{jumpingPawn.position.row + rowJump, jumpingPawn.position.col + colJump};
-                if (isInBoard(newPosition))
-                {
-                    if (gameState.isFree(newPosition))
-                    {
-                        const auto positionBetween = Position{jumpingPawn.position.row + rowJump / pawnBeatOverOponent,
-                                                              jumpingPawn.position.col + colJump / pawnBeatOverOponent};
-                        if (!gameState.isFree(positionBetween))
-                        {
-                            if (gameState.pawnAtPosition(positionBetween).color != jumpingPawn.state.color)
-                            {
-                                auto newGameState = gameState;
-                                newGameState.removePawn(positionBetween);
-                                newGameState.movePawn(jumpingPawn.position, newPosition);
-                                auto newJumpingPawn = jumpingPawn;
-                                newJumpingPawn.position = newPosition;
-                                findJump(newGameState, jump, newJumpingPawn, allJumps);
-                                foundJump = true;
-                            }
-                        }
-                    }
-                }
-            }
+            movingFigures |= bitboard::squareMask<Rules>(jump.from);
         }
     }
     else
     {
-        for (const auto rowWayFactor : {-1, 1})
+        movingFigures = getMoveableFigures(color);
+    }
+    const auto kings = m_gameState.kings();
+    return static_cast<Bitboard>(movingFigures & (type == FigureType::King ? kings : ~kings));
+}
+
+template <typename Rules>
+typename Rules::Bitboard BasicGameController<Rules>::getJumpingFigures(FigureColor color) const
+{
+    const auto figures = m_gameState.figures(color);
+    const auto kings = static_cast<Bitboard>(figures & m_gameState.kings());
+    const auto pawns = static_cast<Bitboard>(figures & ~kings);
+    const auto opponents = m_gameState.figures(FigureState::flipColor(color));
+    const auto occupied = m_gameState.occupied();
+    const auto freeSquares = static_cast<Bitboard>(~occupied);
+
+    Bitboard jumpingFigures = 0u;
+    for (const auto direction : bitboard::allDirections)
+    {
+        if (isPawnCaptureDirection<Rules>(color, direction))
         {
-            for (const auto colWayFactor : {-1, 1})
+            const auto backwards = bitboard::opposite(direction);
+            const auto beatable = static_cast<Bitboard>(opponents & bitboard::shift<Rules>(freeSquares, backwards));
+            jumpingFigures |= bitboard::shift<Rules>(beatable, backwards) & pawns;
+        }
+    }
+    // A king jumps when the first figure on one of its diagonals is an opponent with a free square behind it.
+    for (auto figures = kings; figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        const auto square = bitboard::lowestSquare(figures);
+        for (const auto direction : bitboard::allDirections)
+        {
+            const auto beaten =
+                static_cast<Bitboard>(bitboard::kingAttacks<Rules>(square, occupied, direction) & opponents);
+            if ((bitboard::shift<Rules>(beaten, direction) & freeSquares) != 0u)
             {
-                for (int i = 1; i < boardSize; i++)
-                {
-                    const auto beatenPosition = Position{jumpingPawn.position.row + i * rowWayFactor,
-                                                         jumpingPawn.position.col + i * colWayFactor};
-                    if (!isInBoard(beatenPosition))
-                    {
-                        break;
-                    }
-
-                    if (gameState.isFree(beatenPosition))
-                    {
-                        continue;
-                    }
-                    if (gameState.pawnAtPosition(beatenPosition).color == jumpingPawn.state.color)
-                    {
-                        break;
-                    }
-                    bool beatenBlocked{false};
-                    for (int j = i + 1; j < boardSize; j++)
-                    {
-                        const auto positionBeyond = Position{jumpingPawn.position.row + j * rowWayFactor,
-                                                             jumpingPawn.position.col + j * colWayFactor};
-                        if (!isInBoard(positionBeyond) || !gameState.isFree(positionBeyond))
-                        {
-                            beatenBlocked = true;
-                            break;
-                        }
-                        auto newGameState = gameState;
-                        newGameState.removePawn(beatenPosition);
-                        newGameState.movePawn(jumpingPawn.position, positionBeyond);
-                        auto newJumpingPawn = jumpingPawn;
-                        newJumpingPawn.position = positionBeyond;
-                        findJump(newGameState, jump, newJumpingPawn, allJumps);
-                        foundJump = true;
-                    }
-                    if (beatenBlocked)
-                    {
-                        break;
-                    }
-                }
+                jumpingFigures |= bitboard::squareMask<Rules>(square);
+                break;
             }
         }
     }
-    if (jump.size() > 1 && !foundJump)
+    return jumpingFigures;
+}
+
+template <typename Rules>
+typename Rules::Bitboard BasicGameController<Rules>::getMoveableFigures(FigureColor color) const
+{
+    const auto figures = m_gameState.figures(color);
+    const auto kings = static_cast<Bitboard>(figures & m_gameState.kings());
+    const auto pawns = static_cast<Bitboard>(figures & ~kings);
+    const auto freeSquares = static_cast<Bitboard>(~m_gameState.occupied());
+
+    Bitboard moveableFigures = 0u;
+    for (const auto direction : bitboard::pawnDirections(color))
+    {
+        moveableFigures |= bitboard::shift<Rules>(freeSquares, bitboard::opposite(direction)) & pawns;
+    }
+    for (const auto direction : bitboard::allDirections)
+    {
+        moveableFigures |= bitboard::shift<Rules>(freeSquares, bitboard::opposite(direction)) & kings;
+    }
+    return moveableFigures;
+}
+
+template <typename Rules>
+Figure BasicGameController<Rules>::figureAt(int square, FigureColor color) const
+{
+    const auto type =
+        (m_gameState.kings() & bitboard::squareMask<Rules>(square)) != 0u ? FigureType::King : FigureType::Pawn;
+    return Figure{FigureState{type, color}, bitboard::squarePosition<Rules>(square)};
+}
+
+template <typename Rules>
+void BasicGameController<Rules>::findJump(JumpSearch& search, int square) const
+{
+    auto& jumps = search.jumps;
+    const auto longestJumpSize = jumps.empty() ? 0 : jumps[0].landingsNumber;
+    // Even capturing every remaining opponent figure would not make this chain as long as the ones already found.
+    if (search.jump.landingsNumber + bitboard::popCount(search.opponents) < longestJumpSize)
+    {
+        return;
+    }
+
+    const auto position = bitboard::squareMask<Rules>(square);
+    const auto freeSquares = search.freeSquares;
+    bool foundJump{false};
+    for (const auto direction : bitboard::allDirections)
     {
-        if (isKingChange(jumpingPawn.state, jumpingPawn.position))
+        if (!search.isKing && !isPawnCaptureDirection<Rules>(search.color, direction))
+        {
+            continue;
+        }
+        const auto reachedFigure = search.isKing
+            ? bitboard::kingAttacks<Rules>(square, static_cast<Bitboard>(~freeSquares), direction)
+            : bitboard::shift<Rules>(position, direction);
+        const auto beaten = static_cast<Bitboard>(reachedFigure & search.opponents);
+        if (beaten == 0u)
         {
-            gameState.changePawnType(jumpingPawn.position, FigureType::King);
+            continue;
         }
-        allJumps.push_back({gameState, jump});
+        search.opponents ^= beaten;
+        search.freeSquares = freeSquares | beaten | position;
+        search.jump.captured |= beaten;
+        // A pawn lands right behind the beaten figure, a king anywhere up to the next figure on the diagonal.
+        const auto landings = search.isKing
+            ? bitboard::kingAttacks<Rules>(
+                  bitboard::lowestSquare(beaten), static_cast<Bitboard>(~search.freeSquares), direction)
+            : bitboard::shift<Rules>(beaten, direction);
+        auto landing = static_cast<Bitboard>(landings & search.freeSquares);
+        while (landing != 0u)
+        {
+            const auto landingSquare = bitboard::nearestSquare(landing, direction);
+            const auto landingMask = bitboard::squareMask<Rules>(landingSquare);
+            landing ^= landingMask;
+            search.freeSquares ^= landingMask;
+            search.jump.addLanding(landingSquare);
+            findJump(search, landingSquare);
+            search.jump.removeLastLanding();
+            search.freeSquares ^= landingMask;
+            foundJump = true;
+        }
+        search.jump.captured ^= beaten;
+        search.freeSquares = freeSquares;
+        search.opponents ^= beaten;
+    }
+    if (search.jump.empty() || foundJump || search.jump.landingsNumber < longestJumpSize)
+    {
+        return;
+    }
+    if (search.jump.landingsNumber > longestJumpSize)
+    {
+        jumps.clear();
+    }
+    // Flying kings may capture the same figures in another order and still land on the same square. Such chains lead
+    // to the same position, so only the first of them is kept.
+    const auto isSameJump = [&search](const Move& other) {
+        return other.captured == search.jump.captured && other.to == search.jump.to && other.from == search.jump.from;
+    };
+    if (std::any_of(jumps.begin(), jumps.end(), isSameJump))
+    {
+        return;
     }
+    auto jump = search.jump;
+    const auto type = search.isKing ? FigureType::King : FigureType::Pawn;
+    jump.promotion = isKingChange(FigureState{type, search.color}, bitboard::squarePosition<Rules>(square));
+    jumps.push_back(jump);
 }
-std::vector<GameStateWithMove> GameController::getAvailableMoves(const Figure& pawn) const
+
+template <typename Rules>
+void BasicGameController<Rules>::addAvailableMoves(
+    const Figure& pawn,
+    Bitboard pawnTargets,
+    MoveBuffer& moveList) const
 {
-    std::vector<GameStateWithMove> movesWithGameState;
+    const auto position = bitboard::squareMask<Rules>(pawn.position);
+    const auto occupied = m_gameState.occupied();
+    const auto freeSquares = static_cast<Bitboard>(~occupied);
+    const auto addMove = [this, &pawn, &moveList](int targetSquare) {
+        auto move = Move::startingAt(bitboard::squareIndex<Rules>(pawn.position));
+        move.addLanding(targetSquare);
+        move.promotion = isKingChange(pawn.state, bitboard::squarePosition<Rules>(targetSquare));
+        moveList.push_back(move);
+    };
+
     if (pawn.state.type != FigureType::King)
     {
-        constexpr auto pawnMoveRange = 1;
-        const auto rowDirectionMove = pawn.state.color == FigureColor::White ? pawnMoveRange : -pawnMoveRange;
-
-        for (const auto colMove : {-pawnMoveRange, pawnMoveRange})
+        for (const auto direction : bitboard::pawnDirections(pawn.state.color))
         {
-            const auto movePosition = Position{pawn.position.row + rowDirectionMove, pawn.position.col + colMove};
-            if (isInBoard(movePosition))
+            const auto target =
+                static_cast<Bitboard>(bitboard::shift<Rules>(position, direction) & freeSquares & pawnTargets);
+            if (target != 0u)
             {
-                Move move{pawn.position};
-                if (m_gameState.isFree(movePosition))
-                {
-                    auto gameStateCopy = m_gameState;
-                    gameStateCopy.movePawn(pawn.position, movePosition);
-                    if (isKingChange(pawn.state, movePosition))
-                    {
-                        gameStateCopy.changePawnType(movePosition, FigureType::King);
-                    }
-                    move.push_back(movePosition);
-                    movesWithGameState.push_back({gameStateCopy, move});
-                }
+                addMove(bitboard::lowestSquare(target));
             }
         }
     }
     else
     {
-        for (const auto rowWayFactor : {-1, 1})
+        const auto square = bitboard::squareIndex<Rules>(pawn.position);
+        for (const auto direction : bitboard::allDirections)
         {
-            for (const auto colWayFactor : {-1, 1})
+            auto targets =
+                static_cast<Bitboard>(bitboard::kingAttacks<Rules>(square, occupied, direction) & freeSquares);
+            while (targets != 0u)
             {
-                for (int i = 1; i < boardSize; i++)
-                {
-                    const auto movePosition =
-                        Position{pawn.position.row + rowWayFactor * i, pawn.position.col + colWayFactor * i};
-                    Move move{pawn.position, movePosition};
-                    if (!isInBoard(movePosition) || !m_gameState.isFree(movePosition))
-                    {
-                        break;
-                    }
-                    if (m_gameState.isFree(movePosition))
-                    {
-                        auto gameStateCopy = m_gameState;
-                        gameStateCopy.movePawn(pawn.position, movePosition);
-                        movesWithGameState.push_back({gameStateCopy, move});
-                    }
-                }
+                const auto targetSquare = bitboard::nearestSquare(targets, direction);
+                targets ^= bitboard::squareMask<Rules>(targetSquare);
+                addMove(targetSquare);
             }
         }
     }
-
-    return movesWithGameState;
 }
 
-bool GameController::isKingChange(FigureState pawnState, Position position) const
+template <typename Rules>
+bool BasicGameController<Rules>::isKingChange(FigureState pawnState, Position position) const
 {
     if (pawnState.type == FigureType::King)
     {
         return false;
     }
-    if (pawnState.color == FigureColor::White)
-    {
-        if (position.row == boardSize - 1)
-        {
-            return true;
-        }
-    }
-    else
-    {
-        if (position.row == 0)
-        {
-            return true;
-        }
-    }
-    return false;
+    return (bitboard::squareMask<Rules>(position) & bitboard::promotionRow<Rules>(pawnState.color)) != 0u;
 }
+
+template class BasicGameController<BrazilianRules>;
+template class BasicGameController<InternationalRules>;
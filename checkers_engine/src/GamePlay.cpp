@@ -1,44 +1,55 @@
 #include "GamePlay.hpp"
-#include <algorithm>
+#include <stdexcept>
+#include "PositionHistory.hpp"
 
-bool operator==(const GameStateWithMove& first, const GameStateWithMove& second)
-{
-    return first.gameState == second.gameState;
-}
-
-GamePlay::GamePlay(GameState& gameState, MoveDecisionCallback whiteStrategy, MoveDecisionCallback blackStrategy)
+template <typename Rules>
+BasicGamePlay<Rules>::BasicGamePlay(
+    GameState& gameState,
+    MoveDecisionCallback whiteStrategy,
+    MoveDecisionCallback blackStrategy)
     : currentGameState(gameState), whiteStrategy(std::move(whiteStrategy)), blackStrategy(std::move(blackStrategy))
 {
 }
 
-GameResult GamePlay::start()
+template <typename Rules>
+GameResult BasicGamePlay<Rules>::start()
 {
     constexpr auto movesWithNoBeatWhichMakesDraw = 20;
+    constexpr auto repetitionsWhichMakeDraw = 3;
     FigureColor currentColor{FigureColor::White};
     int movesWithNoBeats = 0;
+    PositionHistory positionHistory;
+    positionHistory.push(currentGameState.hash(currentColor), true);
+    m_playedMoves.clear();
     m_gameplayInterrupted = false;
     while (!m_gameplayInterrupted)
     {
-        GameController gameController(currentGameState);
-        GameStateWithMove decision;
-        std::vector<GameStateWithMove> possibleMoves;
-        possibleMoves = gameController.getPossibleMoves(currentColor);
-        if (possibleMoves.empty())
+        BasicGameController<Rules> gameController(currentGameState);
+        MoveIndex decision{0};
+        const auto moveList = gameController.getMoveList(currentColor);
+        if (moveList.empty())
         {
             m_gameplayInterrupted = true;
             return currentColor == FigureColor::White ? GameResult::BlackWin : GameResult::WhiteWin;
         }
+        const auto possibleMoves = gameController.getPossibleMoves(moveList);
 
         if (currentColor == FigureColor::White)
         {
-            decision = whiteStrategy(currentGameState, possibleMoves);
+            decision = whiteStrategy(currentGameState, possibleMoves, positionHistory);
         }
         else
         {
-            decision = blackStrategy(currentGameState, possibleMoves);
+            decision = blackStrategy(currentGameState, possibleMoves, positionHistory);
         }
         currentColor = FigureState::flipColor(currentColor);
-        if (currentGameState.pawns(currentColor).size() == decision.gameState.pawns(currentColor).size())
+        if (decision >= possibleMoves.size())
+        {
+            m_gameplayInterrupted = true;
+            throw std::runtime_error("Move not allowed");
+        }
+        const auto& move = moveList[decision];
+        if (move.captured == 0u)
         {
             movesWithNoBeats++;
         }
@@ -46,22 +57,36 @@ GameResult GamePlay::start()
         {
             movesWithNoBeats = 0;
         }
-        if (std::find(possibleMoves.cbegin(), possibleMoves.cend(), decision) == possibleMoves.end())
+        if (movesWithNoBeats == movesWithNoBeatWhichMakesDraw)
         {
             m_gameplayInterrupted = true;
-            throw std::runtime_error("Move not allowed");
+            return GameResult::Draw;
         }
-        if (movesWithNoBeats == movesWithNoBeatWhichMakesDraw)
+        const auto irreversible = PositionHistory::isIrreversible(currentGameState, move);
+        currentGameState.makeMove(move);
+        m_playedMoves.push_back(move);
+        const auto hash = currentGameState.hash(currentColor);
+        positionHistory.push(hash, irreversible);
+        if (positionHistory.occurrences(hash) == repetitionsWhichMakeDraw)
         {
             m_gameplayInterrupted = true;
             return GameResult::Draw;
         }
-        currentGameState = decision.gameState;
     }
     return GameResult::GameOn;
 }
 
-void GamePlay::stopGameplay()
+template <typename Rules>
+void BasicGamePlay<Rules>::stopGameplay()
 {
     m_gameplayInterrupted = true;
 }
+
+template <typename Rules>
+const BasicMoveList<Rules>& BasicGamePlay<Rules>::playedMoves() const
+{
+    return m_playedMoves;
+}
+
+template class BasicGamePlay<BrazilianRules>;
+template class BasicGamePlay<InternationalRules>;
@@ -1,80 +1,115 @@
 #include "GameState.hpp"
 
-namespace
-{
-constexpr int rowsCountWithFigures()
+#include <tuple>
+#include "Zobrist.hpp"
+
+template <typename Rules>
+BasicGameState<Rules>::BasicGameState()
 {
-    constexpr auto supportedBoardSize = 8;
-    static_assert(boardSize == supportedBoardSize, "Not handled board size");
-    return 3;
+    for (int row = 0; row < Rules::rowsWithFigures; row++)
+    {
+        for (int col = 0; col < Rules::boardSize; col += 2)
+        {
+            m_whiteFigures |= bitboard::squareMask<Rules>(Position{row, col + row % 2});
+            m_blackFigures |= bitboard::squareMask<Rules>(Position{Rules::boardSize - row - 1, col + (row + 1) % 2});
+        }
+    }
+    m_hash = calculateHash();
 }
-} // namespace
 
-GameState::GameState()
+template <typename Rules>
+BasicGameState<Rules>::BasicGameState(Board&& board)
 {
-    gameState = Board{};
-    for (int row = 0; row < rowsCountWithFigures(); row++)
+    for (int square = 0; square < Rules::squaresNumber; square++)
     {
-        for (auto col = 0u; col < boardSize; col += 2)
+        const auto position = bitboard::squarePosition<Rules>(square);
+        const auto& figure = board[position.row][position.col];
+        if (!figure)
+        {
+            continue;
+        }
+        const auto mask = bitboard::squareMask<Rules>(square);
+        (figure->color == FigureColor::White ? m_whiteFigures : m_blackFigures) |= mask;
+        if (figure->type == FigureType::King)
         {
-            gameState[row][col + row % 2] = FigureState{FigureColor::White};
-            gameState[boardSize - row - 1][col + (row + 1) % 2] = FigureState{FigureColor::Black};
+            m_kings |= mask;
         }
     }
+    m_hash = calculateHash();
 }
 
-GameState::GameState(Board&& board) : gameState(board) {}
-
-void GameState::removePawn(const Position& position)
+template <typename Rules>
+BasicGameState<Rules>::BasicGameState(Bitboard whiteFigures, Bitboard blackFigures, Bitboard kings)
+    : m_whiteFigures{whiteFigures}, m_blackFigures{blackFigures}, m_kings{kings}
 {
-    gameState[position.row][position.col] = std::nullopt;
+    m_hash = calculateHash();
 }
 
-void GameState::movePawn(const Position& from, const Position& to)
+template <typename Rules>
+Figures BasicGameState<Rules>::pawns(FigureColor color) const
 {
-    gameState[to.row][to.col] = gameState[from.row][from.col];
-    removePawn(from);
+    const auto view = figuresView(color);
+    return Figures(view.begin(), view.end());
 }
 
-void GameState::changePawnType(const Position& position, FigureType type)
+template <typename Rules>
+BasicGameState<Rules> BasicGameState<Rules>::mirrored() const
 {
-    gameState[position.row][position.col]->type = type;
+    auto mirror = *this;
+    mirror.m_whiteFigures = bitboard::rotated<Rules>(m_blackFigures);
+    mirror.m_blackFigures = bitboard::rotated<Rules>(m_whiteFigures);
+    mirror.m_kings = bitboard::rotated<Rules>(m_kings);
+    mirror.m_hash = zobrist::mirroredHash(m_hash);
+    return mirror;
 }
 
-bool GameState::isFree(const Position& position) const
+template <typename Rules>
+bool BasicGameState<Rules>::isCanonical() const
 {
-    return !gameState[position.row][position.col].has_value();
+    const auto encoding = std::make_tuple(m_whiteFigures, m_blackFigures, m_kings);
+    const auto mirroredEncoding = std::make_tuple(
+        bitboard::rotated<Rules>(m_blackFigures),
+        bitboard::rotated<Rules>(m_whiteFigures),
+        bitboard::rotated<Rules>(m_kings));
+    return encoding <= mirroredEncoding;
 }
 
-bool GameState::isValid(const Position& position)
+template <typename Rules>
+bool BasicGameState<Rules>::isSymmetric() const
 {
-    const bool rowValid = (position.row >= 0 && position.row < boardSize);
-    const bool colValid = (position.col >= 0 && position.col < boardSize);
-    return rowValid && colValid && (position.col % 2 == (position.row % 2 == 0 ? 0 : 1));
+    return m_whiteFigures == bitboard::rotated<Rules>(m_blackFigures) && m_kings == bitboard::rotated<Rules>(m_kings);
 }
 
-FigureState GameState::pawnAtPosition(const Position& position) const
+template <typename Rules>
+BasicGameState<Rules> BasicGameState<Rules>::canonical() const
 {
-    return gameState[position.row][position.col].value();
+    return isCanonical() ? *this : mirrored();
 }
 
-Figures GameState::pawns(FigureColor color) const
+template <typename Rules>
+std::uint64_t BasicGameState<Rules>::canonicalHash(FigureColor sideToMove) const
 {
-    Figures ret;
-    for (int row = 0; row < boardSize; row++)
+    if (isSymmetric())
     {
-        for (int col = 0 + row % 2; col < boardSize; col += 2)
-        {
-            if (gameState[row][col] && gameState[row][col]->color == color)
-            {
-                ret.push_back({gameState[row][col].value(), {row, col}});
-            }
-        }
+        return hash(FigureColor::White);
+    }
+    if (isCanonical())
+    {
+        return hash(sideToMove);
     }
-    return ret;
+    return zobrist::mirroredHash(m_hash) ^ zobrist::sideToMoveKey<Rules>(FigureState::flipColor(sideToMove));
 }
 
-bool GameState::operator==(const GameState& other) const
+template <typename Rules>
+std::uint64_t BasicGameState<Rules>::calculateHash() const
 {
-    return gameState == other.gameState;
+    std::uint64_t hash = 0u;
+    for (auto figures = occupied(); figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        hash ^= figureKey(bitboard::squareMask<Rules>(bitboard::lowestSquare(figures)));
+    }
+    return hash;
 }
+
+template class BasicGameState<BrazilianRules>;
+template class BasicGameState<InternationalRules>;
@@ -0,0 +1,110 @@
+#include "MoveCache.hpp"
+
+template <typename Rules>
+BasicMoveCache<Rules>::BasicMoveCache(const GameState& gameState) : m_gameState(gameState)
+{
+    refresh(m_gameState.occupied());
+}
+
+template <typename Rules>
+void BasicMoveCache<Rules>::update(const Move& move)
+{
+    const auto changed = static_cast<Bitboard>(
+        bitboard::squareMask<Rules>(move.from) | bitboard::squareMask<Rules>(move.to) | move.captured);
+    const auto occupied = m_gameState.occupied();
+    const auto freeSquares = static_cast<Bitboard>(~occupied);
+
+    // A figure sees a changed square when it is the first one met along a diagonal going back from that square. Pawns
+    // only see their neighbours, so the diagonals are followed further only when there are kings to find.
+    const auto kings = m_gameState.kings();
+    auto affected = changed;
+    for (const auto direction : bitboard::allDirections)
+    {
+        affected |= kings != 0u ? bitboard::kingReach<Rules>(changed, freeSquares, direction)
+                                : bitboard::shift<Rules>(changed, direction);
+    }
+    m_staleFigures |= affected;
+}
+
+template <typename Rules>
+void BasicMoveCache<Rules>::getMoveList(FigureColor color, MoveBuffer& moveBuffer)
+{
+    BasicGameController<Rules>(m_gameState).getJumps(color, moveBuffer);
+    if (!moveBuffer.empty())
+    {
+        return;
+    }
+
+    refresh(static_cast<Bitboard>(m_staleFigures & m_gameState.occupied()));
+    m_staleFigures = 0u;
+    const auto kings = m_gameState.kings();
+    const auto promotionRow = bitboard::promotionRow<Rules>(color);
+    for (auto figures = m_gameState.figures(color); figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        const auto square = bitboard::lowestSquare(figures);
+        const auto position = bitboard::squareMask<Rules>(square);
+        const auto targets = m_targets[square];
+        const auto addMove = [square, &moveBuffer](Bitboard target, bool promotion) {
+            auto move = Move::startingAt(square);
+            move.addLanding(bitboard::lowestSquare(target));
+            move.promotion = promotion;
+            moveBuffer.push_back(move);
+        };
+
+        if ((kings & position) == 0u)
+        {
+            for (const auto direction : bitboard::pawnDirections(color))
+            {
+                const auto target = static_cast<Bitboard>(bitboard::shift<Rules>(position, direction) & targets);
+                if (target != 0u)
+                {
+                    addMove(target, (target & promotionRow) != 0u);
+                }
+            }
+            continue;
+        }
+        for (const auto direction : bitboard::allDirections)
+        {
+            for (auto target = static_cast<Bitboard>(bitboard::shift<Rules>(position, direction) & targets);
+                 target != 0u;
+                 target = bitboard::shift<Rules>(target, direction) & targets)
+            {
+                addMove(target, false);
+            }
+        }
+    }
+}
+
+template <typename Rules>
+void BasicMoveCache<Rules>::refresh(Bitboard figures)
+{
+    const auto occupied = m_gameState.occupied();
+    const auto freeSquares = static_cast<Bitboard>(~occupied);
+    const auto kings = m_gameState.kings();
+    const auto whiteFigures = m_gameState.figures(FigureColor::White);
+    for (; figures != 0u; figures = bitboard::withoutLowestSquare(figures))
+    {
+        const auto square = bitboard::lowestSquare(figures);
+        const auto position = bitboard::squareMask<Rules>(square);
+        Bitboard targets = 0u;
+        if ((kings & position) != 0u)
+        {
+            for (const auto direction : bitboard::allDirections)
+            {
+                targets |= bitboard::kingAttacks<Rules>(square, occupied, direction);
+            }
+        }
+        else
+        {
+            const auto color = (whiteFigures & position) != 0u ? FigureColor::White : FigureColor::Black;
+            for (const auto direction : bitboard::pawnDirections(color))
+            {
+                targets |= bitboard::shift<Rules>(position, direction);
+            }
+        }
+        m_targets[square] = static_cast<Bitboard>(targets & freeSquares);
+    }
+}
+
+template class BasicMoveCache<BrazilianRules>;
+template class BasicMoveCache<InternationalRules>;
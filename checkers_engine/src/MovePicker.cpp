@@ -0,0 +1,144 @@
+#include "MovePicker.hpp"
+
+#include <algorithm>
+
+MovePicker::MovePicker(const GameState& gameState, FigureColor color, const MoveHints& hints)
+    : m_gameController(gameState), m_color(color), m_hints(hints)
+{
+}
+
+std::optional<Move> MovePicker::nextMove()
+{
+    while (m_nextMove == m_moves.size())
+    {
+        if (m_stage == Stage::Done)
+        {
+            return std::nullopt;
+        }
+        generateNextStage();
+    }
+    return m_moves[m_nextMove++];
+}
+
+bool MovePicker::isSameMove(const Move& lhs, const Move& rhs)
+{
+    return lhs.from == rhs.from && lhs.to == rhs.to && lhs.captured == rhs.captured;
+}
+
+void MovePicker::generateNextStage()
+{
+    m_nextMove = 0;
+    m_moves.clear();
+    switch (m_stage)
+    {
+        case Stage::HashMove:
+            pickHashMove();
+            // A legal quiet move means there is no capture, so jumps need not be generated.
+            m_stage = m_moves.empty() ? Stage::Captures : Stage::Killers;
+            break;
+        case Stage::Captures:
+            m_gameController.getJumps(m_color, m_moves);
+            sortByHistory();
+            if (m_hints.hashMove)
+            {
+                const auto hashMove = std::find_if(m_moves.begin(), m_moves.end(), [this](const Move& move) {
+                    return isSameMove(move, *m_hints.hashMove);
+                });
+                if (hashMove != m_moves.end())
+                {
+                    std::rotate(m_moves.begin(), hashMove, hashMove + 1);
+                }
+            }
+            m_stage = m_moves.empty() ? Stage::Killers : Stage::Done;
+            break;
+        case Stage::Killers:
+            pickKillers();
+            m_stage = Stage::Promotions;
+            break;
+        case Stage::Promotions:
+            m_gameController.getPromotions(m_color, m_moves);
+            removePickedMoves();
+            sortByHistory();
+            m_stage = Stage::QuietMoves;
+            break;
+        case Stage::QuietMoves:
+            m_gameController.getQuietMoves(m_color, m_moves);
+            removePickedMoves();
+            sortByHistory();
+            m_stage = Stage::Done;
+            break;
+        case Stage::Done:
+            break;
+    }
+}
+
+void MovePicker::pickHashMove()
+{
+    if (!m_hints.hashMove || m_hints.hashMove->captured != 0u)
+    {
+        return;
+    }
+    const auto hashMove = m_gameController.getQuietMove(m_color, m_hints.hashMove->from, m_hints.hashMove->to);
+    if (hashMove)
+    {
+        m_moves.push_back(*hashMove);
+        m_pickedMoves[m_pickedMovesNumber++] = *hashMove;
+    }
+}
+
+void MovePicker::pickKillers()
+{
+    // Killers come from other positions, so each of them has to be checked to be legal here.
+    for (const auto& killer : m_hints.killers)
+    {
+        if (!killer || killer->captured != 0u || wasPicked(*killer))
+        {
+            continue;
+        }
+        const auto move = m_gameController.getQuietMove(m_color, killer->from, killer->to);
+        if (move)
+        {
+            m_moves.push_back(*move);
+            m_pickedMoves[m_pickedMovesNumber++] = *move;
+        }
+    }
+}
+
+void MovePicker::removePickedMoves()
+{
+    if (m_pickedMovesNumber != 0)
+    {
+        const auto picked =
+            std::remove_if(m_moves.begin(), m_moves.end(), [this](const Move& move) { return wasPicked(move); });
+        m_moves.erase(picked, m_moves.end());
+    }
+}
+
+void MovePicker::sortByHistory()
+{
+    if (m_hints.history == nullptr)
+    {
+        return;
+    }
+
+    // Move lists are short, and insertion sort keeps moves of equal score in place without any allocation.
+    const auto& history = *m_hints.history;
+    for (std::size_t i = 1; i < m_moves.size(); i++)
+    {
+        const auto move = m_moves[i];
+        const auto score = history[move.from][move.to];
+        auto j = i;
+        for (; j > 0 && history[m_moves[j - 1].from][m_moves[j - 1].to] < score; j--)
+        {
+            m_moves[j] = m_moves[j - 1];
+        }
+        m_moves[j] = move;
+    }
+}
+
+bool MovePicker::wasPicked(const Move& move) const
+{
+    return std::any_of(m_pickedMoves.begin(), m_pickedMoves.begin() + m_pickedMovesNumber, [&move](const Move& picked) {
+        return isSameMove(move, picked);
+    });
+}
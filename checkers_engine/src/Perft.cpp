@@ -0,0 +1,99 @@
+#include "Perft.hpp"
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+// One map per remaining depth, so a position reached with a different number of plies left is a separate entry.
+struct TranspositionTable
+{
+    TranspositionTable(int depth, std::size_t entriesLimit) : counts(depth + 1), entriesLimit(entriesLimit) {}
+
+    std::vector<std::unordered_map<std::uint64_t, std::uint64_t>> counts;
+    const std::size_t entriesLimit;
+    std::size_t entriesNumber{0};
+};
+
+std::uint64_t countLeaves(const GameState& gameState, FigureColor sideToMove, int depth, TranspositionTable* table)
+{
+    if (depth == 0)
+    {
+        return 1;
+    }
+    const auto hash = gameState.hash(sideToMove);
+    if (table != nullptr)
+    {
+        const auto& counts = table->counts.at(depth);
+        const auto entry = counts.find(hash);
+        if (entry != counts.end())
+        {
+            return entry->second;
+        }
+    }
+
+    const auto possibleMoves = GameController(gameState).getPossibleMoves(sideToMove);
+    std::uint64_t nodes = 0;
+    if (depth == 1)
+    {
+        nodes = possibleMoves.size();
+    }
+    else
+    {
+        for (const auto& possibleMove : possibleMoves)
+        {
+            nodes += countLeaves(possibleMove.gameState, FigureState::flipColor(sideToMove), depth - 1, table);
+        }
+    }
+
+    if (table != nullptr && table->entriesNumber < table->entriesLimit)
+    {
+        table->entriesNumber += table->counts.at(depth).emplace(hash, nodes).second ? 1 : 0;
+    }
+    return nodes;
+}
+} // namespace
+
+Perft::Perft(PerftOptions options) : m_options(options) {}
+
+std::uint64_t Perft::countNodes(const GameState& gameState, FigureColor sideToMove, int depth) const
+{
+    if (depth <= 0)
+    {
+        return 1;
+    }
+    if (m_options.threadsNumber > 1)
+    {
+        return countNodesInParallel(gameState, sideToMove, depth);
+    }
+    TranspositionTable table(depth, m_options.hashEntriesLimit);
+    return countLeaves(gameState, sideToMove, depth, m_options.hashTranspositions ? &table : nullptr);
+}
+
+std::uint64_t Perft::countNodesInParallel(const GameState& gameState, FigureColor sideToMove, int depth) const
+{
+    const auto rootMoves = GameController(gameState).getPossibleMoves(sideToMove);
+    std::atomic<std::size_t> nextRootMove{0};
+    std::atomic<std::uint64_t> nodes{0};
+
+    const auto threadLoop = [&]() {
+        TranspositionTable table(depth, m_options.hashEntriesLimit);
+        auto* tablePointer = m_options.hashTranspositions ? &table : nullptr;
+        for (auto i = nextRootMove++; i < rootMoves.size(); i = nextRootMove++)
+        {
+            nodes += countLeaves(rootMoves[i].gameState, FigureState::flipColor(sideToMove), depth - 1, tablePointer);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (auto i{0u}; i < m_options.threadsNumber; i++)
+    {
+        threads.emplace_back(threadLoop);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return nodes;
+}
@@ -0,0 +1,33 @@
+#include "PositionHistory.hpp"
+
+void PositionHistory::push(std::uint64_t hash, bool irreversible)
+{
+    m_entries.push_back({hash, irreversible});
+}
+
+void PositionHistory::pop()
+{
+    m_entries.pop_back();
+}
+
+void PositionHistory::clear()
+{
+    m_entries.clear();
+}
+
+int PositionHistory::occurrences(std::uint64_t hash) const
+{
+    int occurrences = 0;
+    for (auto entry = m_entries.rbegin(); entry != m_entries.rend(); ++entry)
+    {
+        if (entry->hash == hash)
+        {
+            occurrences++;
+        }
+        if (entry->irreversible)
+        {
+            break;
+        }
+    }
+    return occurrences;
+}
@@ -0,0 +1,323 @@
+#include "PositionNotation.hpp"
+
+namespace
+{
+constexpr auto bytesPerBitboard = sizeof(Bitboard);
+
+void packBitboard(Bitboard bitboard, std::uint8_t* bytes)
+{
+    for (std::size_t byte = 0; byte < bytesPerBitboard; byte++)
+    {
+        bytes[byte] = static_cast<std::uint8_t>(bitboard >> (8u * byte));
+    }
+}
+
+Bitboard unpackBitboard(const std::uint8_t* bytes)
+{
+    Bitboard bitboard = bitboard::empty;
+    for (std::size_t byte = 0; byte < bytesPerBitboard; byte++)
+    {
+        bitboard |= static_cast<Bitboard>(bytes[byte]) << (8u * byte);
+    }
+    return bitboard;
+}
+
+// Moves have room for as many landings as a side has figures at the start, so neither side may have more.
+bool isValidPosition(Bitboard whiteFigures, Bitboard blackFigures, Bitboard kings)
+{
+    const auto occupied = whiteFigures | blackFigures;
+    return (whiteFigures & blackFigures) == bitboard::empty && (kings & ~occupied) == bitboard::empty &&
+        bitboard::popCount(whiteFigures) <= DefaultRules::figuresNumber &&
+        bitboard::popCount(blackFigures) <= DefaultRules::figuresNumber;
+}
+
+std::optional<FigureColor> colorFromLetter(char letter)
+{
+    switch (letter)
+    {
+        case 'W':
+            return FigureColor::White;
+        case 'B':
+            return FigureColor::Black;
+        default:
+            return std::nullopt;
+    }
+}
+
+char colorLetter(FigureColor color)
+{
+    return color == FigureColor::White ? 'W' : 'B';
+}
+
+// Minimal cursor over the parsed text. Every read reports failure instead of going past the end.
+class Parser
+{
+public:
+    explicit Parser(std::string_view text) : m_text(text) {}
+
+    bool atEnd() const { return m_position == m_text.size(); }
+
+    bool consume(char character)
+    {
+        if (atEnd() || m_text[m_position] != character)
+        {
+            return false;
+        }
+        m_position++;
+        return true;
+    }
+
+    std::optional<char> next()
+    {
+        if (atEnd())
+        {
+            return std::nullopt;
+        }
+        return m_text[m_position++];
+    }
+
+    std::optional<int> pdnSquare()
+    {
+        int number = 0;
+        const auto start = m_position;
+        while (!atEnd() && m_text[m_position] >= '0' && m_text[m_position] <= '9' && m_position - start < 2)
+        {
+            number = number * 10 + (m_text[m_position++] - '0');
+        }
+        if (m_position == start || number < 1 || number > bitboard::squaresNumber)
+        {
+            return std::nullopt;
+        }
+        return number;
+    }
+
+private:
+    std::string_view m_text;
+    std::size_t m_position{0};
+};
+
+bool parseFenSection(Parser& parser, Bitboard& figures, Bitboard& kings)
+{
+    if (parser.atEnd() || parser.consume(':') || parser.consume('.'))
+    {
+        return true;
+    }
+    do
+    {
+        const auto isKing = parser.consume('K');
+        const auto first = parser.pdnSquare();
+        if (!first)
+        {
+            return false;
+        }
+        auto last = first;
+        if (parser.consume('-'))
+        {
+            last = parser.pdnSquare();
+            if (!last || *last < *first)
+            {
+                return false;
+            }
+        }
+        for (auto pdnSquare = *first; pdnSquare <= *last; pdnSquare++)
+        {
+            const auto mask = bitboard::squareMask(notation::squareFromPdn(pdnSquare));
+            figures |= mask;
+            if (isKing)
+            {
+                kings |= mask;
+            }
+        }
+    } while (parser.consume(','));
+    return parser.atEnd() || parser.consume(':') || parser.consume('.');
+}
+
+void appendFenSection(std::string& fen, const GameState& gameState, FigureColor color)
+{
+    fen += ':';
+    fen += colorLetter(color);
+    bool first = true;
+    for (auto pdnSquare = 1; pdnSquare <= bitboard::squaresNumber; pdnSquare++)
+    {
+        const auto mask = bitboard::squareMask(notation::squareFromPdn(pdnSquare));
+        if ((gameState.figures(color) & mask) == bitboard::empty)
+        {
+            continue;
+        }
+        if (!first)
+        {
+            fen += ',';
+        }
+        if ((gameState.kings() & mask) != bitboard::empty)
+        {
+            fen += 'K';
+        }
+        fen += std::to_string(pdnSquare);
+        first = false;
+    }
+}
+
+bool matchesLandings(const Move& move, const std::array<int, Move::maxLandingsNumber + 1>& squares, int squaresNumber)
+{
+    if (move.from != squares[0] || move.to != squares[squaresNumber - 1])
+    {
+        return false;
+    }
+    if (squaresNumber == 2)
+    {
+        return true;
+    }
+    if (move.landingsNumber != squaresNumber - 1)
+    {
+        return false;
+    }
+    for (auto landing = 0; landing < move.landingsNumber; landing++)
+    {
+        if (move.landing(landing) != squares[landing + 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+namespace notation
+{
+int pdnSquare(int square)
+{
+    const auto row = square / bitboard::squaresPerRow;
+    return (boardSize - 1 - row) * bitboard::squaresPerRow + square % bitboard::squaresPerRow + 1;
+}
+
+int squareFromPdn(int pdnSquare)
+{
+    const auto row = boardSize - 1 - (pdnSquare - 1) / bitboard::squaresPerRow;
+    return row * bitboard::squaresPerRow + (pdnSquare - 1) % bitboard::squaresPerRow;
+}
+
+PackedPosition pack(const GameState& gameState)
+{
+    PackedPosition packedPosition{};
+    packBitboard(gameState.figures(FigureColor::White), packedPosition.data());
+    packBitboard(gameState.figures(FigureColor::Black), packedPosition.data() + bytesPerBitboard);
+    packBitboard(gameState.kings(), packedPosition.data() + 2 * bytesPerBitboard);
+    return packedPosition;
+}
+
+std::optional<GameState> unpack(const PackedPosition& packedPosition)
+{
+    const auto whiteFigures = unpackBitboard(packedPosition.data());
+    const auto blackFigures = unpackBitboard(packedPosition.data() + bytesPerBitboard);
+    const auto kings = unpackBitboard(packedPosition.data() + 2 * bytesPerBitboard);
+    if (!isValidPosition(whiteFigures, blackFigures, kings))
+    {
+        return std::nullopt;
+    }
+    return GameState{whiteFigures, blackFigures, kings};
+}
+
+std::string toFen(const GameState& gameState, FigureColor sideToMove)
+{
+    std::string fen;
+    fen.reserve(4 * bitboard::squaresNumber);
+    fen += colorLetter(sideToMove);
+    appendFenSection(fen, gameState, FigureColor::White);
+    appendFenSection(fen, gameState, FigureColor::Black);
+    return fen;
+}
+
+std::optional<FenPosition> fromFen(std::string_view fen)
+{
+    Parser parser{fen};
+    const auto sideToMove = colorFromLetter(parser.next().value_or(' '));
+    if (!sideToMove || !parser.consume(':'))
+    {
+        return std::nullopt;
+    }
+    std::array<Bitboard, 2> figures{bitboard::empty, bitboard::empty};
+    std::array<bool, 2> sectionParsed{false, false};
+    Bitboard kings = bitboard::empty;
+    while (!parser.atEnd())
+    {
+        const auto color = colorFromLetter(parser.next().value_or(' '));
+        if (!color)
+        {
+            return std::nullopt;
+        }
+        const auto colorIndex = static_cast<std::size_t>(*color == FigureColor::Black);
+        if (sectionParsed[colorIndex] || !parseFenSection(parser, figures[colorIndex], kings))
+        {
+            return std::nullopt;
+        }
+        sectionParsed[colorIndex] = true;
+    }
+    if (!sectionParsed[0] || !sectionParsed[1] || !isValidPosition(figures[0], figures[1], kings))
+    {
+        return std::nullopt;
+    }
+    return FenPosition{GameState{figures[0], figures[1], kings}, *sideToMove};
+}
+
+std::string toPdn(const Move& move)
+{
+    if (move.empty())
+    {
+        return {};
+    }
+    const auto separator = move.captured != bitboard::empty ? 'x' : '-';
+    auto pdn = std::to_string(pdnSquare(move.from));
+    for (auto landing = 0; landing < move.landingsNumber; landing++)
+    {
+        pdn += separator;
+        pdn += std::to_string(pdnSquare(move.landing(landing)));
+    }
+    return pdn;
+}
+
+std::optional<Move> moveFromPdn(std::string_view pdn, const MoveList& legalMoves)
+{
+    Parser parser{pdn};
+    std::array<int, Move::maxLandingsNumber + 1> squares{};
+    auto squaresNumber = 0;
+    const auto first = parser.pdnSquare();
+    if (!first)
+    {
+        return std::nullopt;
+    }
+    squares[squaresNumber++] = squareFromPdn(*first);
+    const auto isJump = !parser.atEnd() && parser.consume('x');
+    if (!isJump && !parser.consume('-'))
+    {
+        return std::nullopt;
+    }
+    do
+    {
+        const auto square = parser.pdnSquare();
+        if (!square || squaresNumber == static_cast<int>(squares.size()))
+        {
+            return std::nullopt;
+        }
+        squares[squaresNumber++] = squareFromPdn(*square);
+    } while (parser.consume(isJump ? 'x' : '-'));
+    if (!parser.atEnd())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Move> foundMove;
+    for (const auto& move : legalMoves)
+    {
+        if ((move.captured != bitboard::empty) != isJump || !matchesLandings(move, squares, squaresNumber))
+        {
+            continue;
+        }
+        if (foundMove)
+        {
+            return std::nullopt;
+        }
+        foundMove = move;
+    }
+    return foundMove;
+}
+} // namespace notation
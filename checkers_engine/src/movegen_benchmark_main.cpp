@@ -0,0 +1,121 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "MoveCache.hpp"
+#include "PositionNotation.hpp"
+
+namespace
+{
+void printUsage(const char* programName)
+{
+    std::cout << "Usage: " << programName << " <depth> [--fen <position>]" << std::endl;
+    std::cout << "\t--fen <position>\tstart from the given position instead of the initial one" << std::endl;
+}
+
+// Both walks visit the same tree with makeMove and unmakeMove on a single position, so they differ only in the way
+// the move list of every node is obtained.
+std::uint64_t countWithRegeneration(GameState& gameState, FigureColor sideToMove, int depth)
+{
+    MoveBuffer moves;
+    GameController(gameState).getMoveList(sideToMove, moves);
+    if (depth == 1)
+    {
+        return moves.size();
+    }
+    std::uint64_t nodes = 0;
+    for (const auto& move : moves)
+    {
+        const auto undoRecord = gameState.makeMove(move);
+        nodes += countWithRegeneration(gameState, FigureState::flipColor(sideToMove), depth - 1);
+        gameState.unmakeMove(move, undoRecord);
+    }
+    return nodes;
+}
+
+std::uint64_t countWithCache(GameState& gameState, MoveCache& moveCache, FigureColor sideToMove, int depth)
+{
+    MoveBuffer moves;
+    moveCache.getMoveList(sideToMove, moves);
+    if (depth == 1)
+    {
+        return moves.size();
+    }
+    std::uint64_t nodes = 0;
+    for (const auto& move : moves)
+    {
+        const auto undoRecord = gameState.makeMove(move);
+        moveCache.update(move);
+        nodes += countWithCache(gameState, moveCache, FigureState::flipColor(sideToMove), depth - 1);
+        gameState.unmakeMove(move, undoRecord);
+        moveCache.update(move);
+    }
+    return nodes;
+}
+
+template <typename Count>
+double measureMilliseconds(Count count, std::uint64_t& nodes)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    nodes = count();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+    return elapsed.count();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2 && argc != 4)
+    {
+        printUsage(argv[0]); // NOLINT
+        return 1;
+    }
+
+    int depth = 0;
+    notation::FenPosition position{GameState{}, FigureColor::White};
+    try
+    {
+        depth = std::stoi(argv[1]); // NOLINT
+    }
+    catch (const std::logic_error&)
+    {
+        printUsage(argv[0]); // NOLINT
+        return 1;
+    }
+    if (argc == 4)
+    {
+        const auto fenPosition = notation::fromFen(argv[3]); // NOLINT
+        if (std::string(argv[2]) != "--fen" || !fenPosition) // NOLINT
+        {
+            printUsage(argv[0]); // NOLINT
+            return 1;
+        }
+        position = *fenPosition;
+    }
+
+    std::cout << std::setw(5) << "ply" << std::setw(16) << "nodes" << std::setw(18) << "regenerate [ms]"
+              << std::setw(14) << "cache [ms]" << std::endl;
+    for (auto ply = 1; ply <= depth; ply++)
+    {
+        auto gameState = position.gameState;
+        std::uint64_t regeneratedNodes = 0;
+        const auto regenerationTime = measureMilliseconds(
+            [&]() { return countWithRegeneration(gameState, position.sideToMove, ply); }, regeneratedNodes);
+        MoveCache moveCache(gameState);
+        std::uint64_t cachedNodes = 0;
+        const auto cacheTime = measureMilliseconds(
+            [&]() { return countWithCache(gameState, moveCache, position.sideToMove, ply); }, cachedNodes);
+        if (cachedNodes != regeneratedNodes)
+        {
+            std::cerr << "Node counts differ at ply " << ply << ": " << regeneratedNodes << " != " << cachedNodes
+                      << std::endl;
+            return 1;
+        }
+        std::cout << std::setw(5) << ply << std::setw(16) << regeneratedNodes << std::setw(18) << std::fixed
+                  << std::setprecision(1) << regenerationTime << std::setw(14) << cacheTime << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <stdexcept>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Perft.hpp"
+
+namespace
+{
+void printUsage(const char* programName)
+{
+    std::cout << "Usage: " << programName << " <depth> [--threads <number>] [--hash] [--black]" << std::endl;
+    std::cout << "\t--threads <number>\tsplit root moves across threads" << std::endl;
+    std::cout << "\t--hash\t\t\treuse leaf counts of transposed positions" << std::endl;
+    std::cout << "\t--black\t\t\tblack moves first" << std::endl;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printUsage(argv[0]); // NOLINT
+        return 1;
+    }
+
+    int depth = 0;
+    PerftOptions options;
+    FigureColor sideToMove = FigureColor::White;
+    try
+    {
+        depth = std::stoi(argv[1]); // NOLINT
+        for (auto i = 2; i < argc; i++)
+        {
+            const std::string argument = argv[i]; // NOLINT
+            if (argument == "--threads" && i + 1 < argc)
+            {
+                options.threadsNumber = static_cast<unsigned int>(std::stoul(argv[++i])); // NOLINT
+            }
+            else if (argument == "--hash")
+            {
+                options.hashTranspositions = true;
+            }
+            else if (argument == "--black")
+            {
+                sideToMove = FigureColor::Black;
+            }
+            else
+            {
+                printUsage(argv[0]); // NOLINT
+                return 1;
+            }
+        }
+    }
+    catch (const std::logic_error&)
+    {
+        printUsage(argv[0]); // NOLINT
+        return 1;
+    }
+
+    const GameState gameState;
+    const Perft perft{options};
+    std::cout << std::setw(5) << "ply" << std::setw(16) << "nodes" << std::setw(12) << "time [ms]" << std::setw(16)
+              << "nodes/s" << std::endl;
+    for (auto ply = 1; ply <= depth; ply++)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        const auto nodes = perft.countNodes(gameState, sideToMove, ply);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        const auto nodesPerSecond = elapsed.count() > 0 ? static_cast<double>(nodes) / elapsed.count() : 0.0;
+        std::cout << std::setw(5) << ply << std::setw(16) << nodes << std::setw(12) << std::fixed
+                  << std::setprecision(1) << elapsed.count() * 1000 << std::setw(16) << std::setprecision(0)
+                  << nodesPerSecond << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "Bitboard.hpp"
+
+using bitboard::Direction;
+
+TEST(Bitboard, SquareIndexShouldMatchPosition)
+{
+    for (int square = 0; square < bitboard::squaresNumber; square++)
+    {
+        const auto position = bitboard::squarePosition(square);
+        EXPECT_TRUE(bitboard::isPlayable(position));
+        EXPECT_EQ(bitboard::squareIndex(position), square);
+    }
+    EXPECT_EQ(bitboard::squareMask(Position{0, 1}), bitboard::empty);
+}
+
+TEST(Bitboard, ShiftShouldMoveSquaresDiagonally)
+{
+    const auto center = bitboard::squareMask(Position{3, 3});
+    EXPECT_EQ(bitboard::shift(center, Direction::SouthWest), bitboard::squareMask(Position{2, 2}));
+    EXPECT_EQ(bitboard::shift(center, Direction::SouthEast), bitboard::squareMask(Position{2, 4}));
+    EXPECT_EQ(bitboard::shift(center, Direction::NorthWest), bitboard::squareMask(Position{4, 2}));
+    EXPECT_EQ(bitboard::shift(center, Direction::NorthEast), bitboard::squareMask(Position{4, 4}));
+}
+
+TEST(Bitboard, ShiftShouldDropSquaresLeavingBoard)
+{
+    const auto westCorner = bitboard::squareMask(Position{0, 0});
+    const auto eastSide = bitboard::squareMask(Position{3, 7});
+    EXPECT_EQ(bitboard::shift(westCorner, Direction::SouthWest), bitboard::empty);
+    EXPECT_EQ(bitboard::shift(westCorner, Direction::NorthWest), bitboard::empty);
+    EXPECT_EQ(bitboard::shift(westCorner, Direction::NorthEast), bitboard::squareMask(Position{1, 1}));
+    EXPECT_EQ(bitboard::shift(eastSide, Direction::NorthEast), bitboard::empty);
+    EXPECT_EQ(bitboard::shift(eastSide, Direction::SouthEast), bitboard::empty);
+    EXPECT_EQ(bitboard::shift(bitboard::rowMask(boardSize - 1), Direction::NorthWest), bitboard::empty);
+}
+
+TEST(Bitboard, SlidingAttacksShouldStopOnFirstOccupiedSquare)
+{
+    const auto origin = bitboard::squareMask(Position{0, 0});
+    const auto blocker = bitboard::squareMask(Position{4, 4});
+    const auto attacks = bitboard::slidingAttacks(origin, ~(origin | blocker), Direction::NorthEast);
+    EXPECT_EQ(
+        attacks,
+        bitboard::squareMask(Position{1, 1}) | bitboard::squareMask(Position{2, 2}) |
+            bitboard::squareMask(Position{3, 3}) | blocker);
+}
+
+TEST(Bitboard, RayShouldReachEdgeOfBoard)
+{
+    const auto& cornerRays = bitboard::rays<>[bitboard::squareIndex(Position{0, 0})];
+    const auto northEastRay = cornerRays[static_cast<std::size_t>(Direction::NorthEast)];
+    EXPECT_EQ(bitboard::popCount(northEastRay), boardSize - 1);
+    EXPECT_NE(northEastRay & bitboard::squareMask(Position{7, 7}), 0u);
+    EXPECT_EQ(cornerRays[static_cast<std::size_t>(Direction::SouthWest)], bitboard::empty);
+}
+
+namespace
+{
+template <typename Rules>
+void expectRayAttacksToMatchSlidingAttacks()
+{
+    std::mt19937_64 generator{5};
+    for (auto sample = 0; sample < 200; sample++)
+    {
+        const auto occupied = static_cast<typename Rules::Bitboard>(generator() & bitboard::allSquares<Rules>());
+        for (auto square = 0; square < Rules::squaresNumber; square++)
+        {
+            const auto origin = bitboard::squareMask<Rules>(square);
+            for (const auto direction : bitboard::allDirections)
+            {
+                EXPECT_EQ(
+                    bitboard::rayAttacks<Rules>(square, occupied, direction),
+                    bitboard::slidingAttacks<Rules>(origin, ~occupied, direction));
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(Bitboard, RayAttacksShouldMatchSlidingAttacks)
+{
+    expectRayAttacksToMatchSlidingAttacks<BrazilianRules>();
+    expectRayAttacksToMatchSlidingAttacks<InternationalRules>();
+}
+
+TEST(Bitboard, ShiftShouldFollowInternationalBoardLayout)
+{
+    using Rules = InternationalRules;
+    const auto center = bitboard::squareMask<Rules>(Position{5, 5});
+    EXPECT_EQ(bitboard::shift<Rules>(center, Direction::SouthWest), bitboard::squareMask<Rules>(Position{4, 4}));
+    EXPECT_EQ(bitboard::shift<Rules>(center, Direction::SouthEast), bitboard::squareMask<Rules>(Position{4, 6}));
+    EXPECT_EQ(bitboard::shift<Rules>(center, Direction::NorthWest), bitboard::squareMask<Rules>(Position{6, 4}));
+    EXPECT_EQ(bitboard::shift<Rules>(center, Direction::NorthEast), bitboard::squareMask<Rules>(Position{6, 6}));
+
+    const auto eastCorner = bitboard::squareMask<Rules>(Position{9, 9});
+    EXPECT_EQ(bitboard::squareIndex<Rules>(Position{9, 9}), Rules::squaresNumber - 1);
+    EXPECT_EQ(bitboard::shift<Rules>(eastCorner, Direction::NorthEast), 0u);
+    EXPECT_EQ(bitboard::shift<Rules>(eastCorner, Direction::NorthWest), 0u);
+    EXPECT_EQ(bitboard::shift<Rules>(bitboard::rowMask<Rules>(9), Direction::NorthWest), 0u);
+    EXPECT_EQ(bitboard::rotated<Rules>(bitboard::squareMask<Rules>(0)), eastCorner);
+    EXPECT_EQ(bitboard::popCount(bitboard::allSquares<Rules>()), 50);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "BoardBatch.hpp"
+#include "GameController.hpp"
+
+namespace
+{
+Bitboard originsOf(const MoveList& moveList)
+{
+    Bitboard origins = bitboard::empty;
+    for (const auto& move : moveList)
+    {
+        origins |= bitboard::squareMask(move.from);
+    }
+    return origins;
+}
+
+std::vector<GameState> playRandomGames(std::size_t gamesNumber, int pliesNumber)
+{
+    std::mt19937 generator{7};
+    std::vector<GameState> gameStates;
+    for (std::size_t game = 0; game < gamesNumber; game++)
+    {
+        GameState gameState;
+        auto color = FigureColor::White;
+        const auto plies = static_cast<int>(generator() % static_cast<unsigned int>(pliesNumber));
+        for (auto ply = 0; ply < plies; ply++)
+        {
+            const auto moveList = GameController(gameState).getMoveList(color);
+            if (moveList.empty())
+            {
+                break;
+            }
+            gameState.makeMove(moveList.at(generator() % moveList.size()));
+            color = FigureState::flipColor(color);
+        }
+        gameStates.push_back(gameState);
+    }
+    return gameStates;
+}
+} // namespace
+
+TEST(BoardBatch, ShouldStoreBoardsInBatch)
+{
+    BoardBatch batch{3};
+    EXPECT_EQ(batch.size(), 3);
+    GameState gameState;
+    gameState.removePawn({2, 2});
+    gameState.changePawnType({0, 0}, FigureType::King);
+    batch.set(1, gameState);
+    EXPECT_EQ(batch.get(1), gameState);
+    EXPECT_EQ(batch.get(0), GameState(bitboard::empty, bitboard::empty, bitboard::empty));
+}
+
+TEST(BoardBatch, MasksShouldMatchMovesGeneratedForEveryBoard)
+{
+    // Not a multiple of the lanes number, so the padding is exercised too.
+    const auto gameStates = playRandomGames(3 * BoardBatch::lanesNumber + 5, 60);
+    BoardBatch batch{gameStates.size()};
+    for (std::size_t board = 0; board < gameStates.size(); board++)
+    {
+        batch.set(board, gameStates[board]);
+    }
+
+    BatchMasks masks;
+    for (const auto color : {FigureColor::White, FigureColor::Black})
+    {
+        batch.computeMasks(color, masks);
+        ASSERT_EQ(masks.moveableFigures.size(), gameStates.size());
+        ASSERT_EQ(masks.jumpingFigures.size(), gameStates.size());
+        ASSERT_EQ(masks.figuresNumber.size(), gameStates.size());
+        ASSERT_EQ(masks.opponentFiguresNumber.size(), gameStates.size());
+        for (std::size_t board = 0; board < gameStates.size(); board++)
+        {
+            const auto& gameState = gameStates[board];
+            const GameController controller(gameState);
+            EXPECT_EQ(masks.jumpingFigures[board], controller.getJumpingFigures(color));
+            // Only the longest captures are legal, so the capture mask may hold figures which cannot move.
+            const auto origins = originsOf(controller.getMoveList(color));
+            EXPECT_EQ(
+                origins,
+                controller.movablePiecesMask(color, FigureType::Pawn) |
+                    controller.movablePiecesMask(color, FigureType::King));
+            if (masks.jumpingFigures[board] != bitboard::empty)
+            {
+                EXPECT_EQ(origins & ~masks.jumpingFigures[board], bitboard::empty);
+            }
+            else
+            {
+                EXPECT_EQ(masks.moveableFigures[board], origins);
+            }
+            EXPECT_EQ(masks.figuresNumber[board], gameState.figuresNumber(color));
+            EXPECT_EQ(masks.opponentFiguresNumber[board], gameState.figuresNumber(FigureState::flipColor(color)));
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <random>
 
 #include "GameController.hpp"
 
@@ -19,13 +20,13 @@ TEST(GameController, DefaultState)
     {
         EXPECT_EQ(possibility.gameState.pawns(FigureColor::White).size(), 12);
         EXPECT_EQ(possibility.gameState.pawns(FigureColor::Black).size(), 12);
-        EXPECT_EQ(possibility.move.size(), 2);
+        EXPECT_EQ(possibility.move.path().size(), 2);
     }
     for (const auto& possibility : possibleBlackMoves)
     {
         EXPECT_EQ(possibility.gameState.pawns(FigureColor::White).size(), 12);
         EXPECT_EQ(possibility.gameState.pawns(FigureColor::Black).size(), 12);
-        EXPECT_EQ(possibility.move.size(), 2);
+        EXPECT_EQ(possibility.move.path().size(), 2);
     }
 
     EXPECT_TRUE(possibleWhiteMoves[0].gameState.isFree({2, 0}));
@@ -107,12 +108,12 @@ TEST(GameController, PawnSingleMoves)
     const auto whiteMoves = controller.getPossibleMoves(FigureColor::White);
     EXPECT_EQ(blackMoves.size(), 1);
     EXPECT_EQ(whiteMoves.size(), 2);
-    Move blackMove1{{2, 0}, {1, 1}};
-    Move whiteMove1{{2, 2}, {3, 1}};
-    Move whiteMove2{{2, 2}, {3, 3}};
-    EXPECT_EQ(blackMoves.at(0).move, blackMove1);
-    EXPECT_EQ(whiteMoves.at(0).move, whiteMove1);
-    EXPECT_EQ(whiteMoves.at(1).move, whiteMove2);
+    Path blackMove1{{2, 0}, {1, 1}};
+    Path whiteMove1{{2, 2}, {3, 1}};
+    Path whiteMove2{{2, 2}, {3, 3}};
+    EXPECT_EQ(blackMoves.at(0).move.path(), blackMove1);
+    EXPECT_EQ(whiteMoves.at(0).move.path(), whiteMove1);
+    EXPECT_EQ(whiteMoves.at(1).move.path(), whiteMove2);
 }
 TEST(GameController, PawnKingChange)
 {
@@ -149,17 +150,17 @@ TEST(GameController, PawnsBeatsOnly)
     const auto whiteMoves = controller.getPossibleMoves(FigureColor::White);
     EXPECT_EQ(blackMoves.size(), 2);
     EXPECT_EQ(whiteMoves.size(), 2);
-    Move blackMove1{{2, 2}, {0, 4}};
-    Move blackMove2{{2, 4}, {0, 2}};
-    EXPECT_EQ(blackMoves.at(0).move, blackMove1);
+    Path blackMove1{{2, 2}, {0, 4}};
+    Path blackMove2{{2, 4}, {0, 2}};
+    EXPECT_EQ(blackMoves.at(0).move.path(), blackMove1);
     EXPECT_TRUE(blackMoves.at(0).gameState.isFree({1, 3}));
-    EXPECT_EQ(blackMoves.at(1).move, blackMove2);
+    EXPECT_EQ(blackMoves.at(1).move.path(), blackMove2);
     EXPECT_TRUE(blackMoves.at(1).gameState.isFree({1, 3}));
-    Move whiteMove1{{1, 3}, {3, 1}};
-    Move whiteMove2{{1, 3}, {3, 5}};
-    EXPECT_EQ(whiteMoves.at(0).move, whiteMove1);
+    Path whiteMove1{{1, 3}, {3, 1}};
+    Path whiteMove2{{1, 3}, {3, 5}};
+    EXPECT_EQ(whiteMoves.at(0).move.path(), whiteMove1);
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({2, 2}));
-    EXPECT_EQ(whiteMoves.at(1).move, whiteMove2);
+    EXPECT_EQ(whiteMoves.at(1).move.path(), whiteMove2);
     EXPECT_TRUE(whiteMoves.at(1).gameState.isFree({2, 4}));
 }
 TEST(GameController, PawnsBeatBlocked)
@@ -176,8 +177,8 @@ TEST(GameController, PawnsBeatBlocked)
     GameController controller(gameState);
     const auto blackMoves = controller.getPossibleMoves(FigureColor::Black);
     EXPECT_EQ(blackMoves.size(), 1);
-    Move blackMove1{{1, 1}, {0, 2}};
-    EXPECT_EQ(blackMoves.at(0).move, blackMove1);
+    Path blackMove1{{1, 1}, {0, 2}};
+    EXPECT_EQ(blackMoves.at(0).move.path(), blackMove1);
 }
 TEST(GameController, PawnsMultiBeats)
 {
@@ -194,8 +195,8 @@ TEST(GameController, PawnsMultiBeats)
     GameController controller(gameState);
     const auto whiteMoves = controller.getPossibleMoves(FigureColor::White);
     EXPECT_EQ(whiteMoves.size(), 1);
-    Move whiteMove1{{0, 0}, {2, 2}, {0, 4}, {2, 6}};
-    EXPECT_EQ(whiteMoves.at(0).move, whiteMove1);
+    Path whiteMove1{{0, 0}, {2, 2}, {0, 4}, {2, 6}};
+    EXPECT_EQ(whiteMoves.at(0).move.path(), whiteMove1);
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 1}));
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 3}));
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 5}));
@@ -219,12 +220,38 @@ TEST(GameController, PawnsMultiBeatsSelectsStronger)
     GameController controller(gameState);
     const auto whiteMoves = controller.getPossibleMoves(FigureColor::White);
     EXPECT_EQ(whiteMoves.size(), 1);
-    Move whiteMove1{{0, 0}, {2, 2}, {0, 4}, {2, 6}};
-    EXPECT_EQ(whiteMoves.at(0).move, whiteMove1);
+    Path whiteMove1{{0, 0}, {2, 2}, {0, 4}, {2, 6}};
+    EXPECT_EQ(whiteMoves.at(0).move.path(), whiteMove1);
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 1}));
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 3}));
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 5}));
 }
+
+TEST(GameController, PawnsMultiBeatsSelectsLongestOfWholeSide)
+{
+    //    5-----x-
+    //    4------o
+    //    3-------
+    //    2-------
+    //    1-x-x-x-
+    //    0o------
+    //     01234567
+    Board board{};
+    board[0][0] = FigureState{FigureColor::White};
+    board[4][6] = FigureState{FigureColor::White};
+    board[1][1] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[1][3] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[1][5] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[5][5] = FigureState{FigureType::Pawn, FigureColor::Black};
+    GameState gameState(std::move(board));
+    GameController controller(gameState);
+    const auto whiteMoves = controller.getMoveList(FigureColor::White);
+    ASSERT_EQ(whiteMoves.size(), 1);
+    Path whiteMove1{{0, 0}, {2, 2}, {0, 4}, {2, 6}};
+    EXPECT_EQ(whiteMoves.at(0).path(), whiteMove1);
+    EXPECT_EQ(controller.countMoves(FigureColor::White), 1);
+    EXPECT_EQ(controller.movablePiecesMask(FigureColor::White, FigureType::Pawn), bitboard::squareMask(Position{0, 0}));
+}
 TEST(GameController, PawnsMultiBeatsMultiOptions)
 {
     //    6-------
@@ -246,10 +273,10 @@ TEST(GameController, PawnsMultiBeatsMultiOptions)
     GameController controller(gameState);
     const auto whiteMoves = controller.getPossibleMoves(FigureColor::White);
     EXPECT_EQ(whiteMoves.size(), 2);
-    Move whiteMove1{{0, 0}, {2, 2}, {0, 4}, {2, 6}};
-    Move whiteMove2{{0, 0}, {2, 2}, {4, 4}, {6, 6}};
-    EXPECT_EQ(whiteMoves.at(0).move, whiteMove1);
-    EXPECT_EQ(whiteMoves.at(1).move, whiteMove2);
+    Path whiteMove1{{0, 0}, {2, 2}, {0, 4}, {2, 6}};
+    Path whiteMove2{{0, 0}, {2, 2}, {4, 4}, {6, 6}};
+    EXPECT_EQ(whiteMoves.at(0).move.path(), whiteMove1);
+    EXPECT_EQ(whiteMoves.at(1).move.path(), whiteMove2);
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 1}));
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 3}));
     EXPECT_TRUE(whiteMoves.at(0).gameState.isFree({1, 5}));
@@ -316,7 +343,267 @@ TEST(GameController, KingsMultiBeat)
     const auto whiteMoves = controller.getPossibleMoves(FigureColor::White);
     EXPECT_EQ(whiteMoves.size(), 1);
     const auto whiteMove1 =
-        Move{Position{0, 0}, Position{2, 2}, Position{4, 4}, Position{6, 2}, Position{2, 6}, Position{0, 4}};
+        Path{Position{0, 0}, Position{2, 2}, Position{4, 4}, Position{6, 2}, Position{2, 6}, Position{0, 4}};
+
+    EXPECT_EQ(whiteMoves.at(0).move.path(), whiteMove1);
+}
 
-    EXPECT_EQ(whiteMoves.at(0).move, whiteMove1);
+TEST(GameController, KingCaptureAroundLoopShouldBeListedOnce)
+{
+    //    5-------
+    //    4--x-x--
+    //    3-------
+    //    2--x-x--
+    //    1---K---
+    //     0123456
+    Board board{};
+    board[1][3] = FigureState{FigureType::King, FigureColor::White};
+    board[2][2] = FigureState{FigureColor::Black};
+    board[2][4] = FigureState{FigureColor::Black};
+    board[4][2] = FigureState{FigureColor::Black};
+    board[4][4] = FigureState{FigureColor::Black};
+    GameState gameState(std::move(board));
+    const auto whiteMoves = GameController(gameState).getMoveList(FigureColor::White);
+    for (auto first = whiteMoves.begin(); first != whiteMoves.end(); ++first)
+    {
+        EXPECT_EQ(first->landingsNumber, 4);
+        for (auto second = std::next(first); second != whiteMoves.end(); ++second)
+        {
+            EXPECT_FALSE(first->captured == second->captured && first->to == second->to);
+        }
+    }
+    const auto backToOrigin = std::count_if(whiteMoves.begin(), whiteMoves.end(), [](const Move& move) {
+        return move.destination() == Position{1, 3};
+    });
+    EXPECT_EQ(backToOrigin, 1);
+}
+
+TEST(GameController, MoveListDescribesCapturesAndPromotions)
+{
+    //    7-------
+    //    6--x----
+    //    5-o---x-
+    //    4----o--
+    //     0123456
+    Board board{};
+    board[5][1] = FigureState{FigureColor::White};
+    board[6][2] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[4][4] = FigureState{FigureColor::White};
+    board[5][5] = FigureState{FigureType::Pawn, FigureColor::Black};
+    GameState gameState(std::move(board));
+    GameController controller(gameState);
+    const auto whiteMoves = controller.getMoveList(FigureColor::White);
+    ASSERT_EQ(whiteMoves.size(), 2);
+    EXPECT_EQ(whiteMoves.at(0).path(), (Path{{4, 4}, {6, 6}}));
+    EXPECT_EQ(whiteMoves.at(0).captured, bitboard::squareMask(Position{5, 5}));
+    EXPECT_FALSE(whiteMoves.at(0).promotion);
+    EXPECT_EQ(whiteMoves.at(1).path(), (Path{{5, 1}, {7, 3}}));
+    EXPECT_EQ(whiteMoves.at(1).captured, bitboard::squareMask(Position{6, 2}));
+    EXPECT_TRUE(whiteMoves.at(1).promotion);
+
+    const auto possibleMoves = controller.getPossibleMoves(whiteMoves);
+    ASSERT_EQ(possibleMoves.size(), 2);
+    EXPECT_EQ(possibleMoves.at(1).gameState.pawnAtPosition({7, 3}).type, FigureType::King);
+    EXPECT_TRUE(possibleMoves.at(1).gameState.isFree({6, 2}));
+}
+
+TEST(GameController, MoveShouldExpandIntoPathOfLandings)
+{
+    auto move = Move::startingAt(bitboard::squareIndex({0, 0}));
+    EXPECT_TRUE(move.empty());
+    EXPECT_TRUE(move.path().empty());
+    move.addLanding(bitboard::squareIndex({2, 2}));
+    move.addLanding(bitboard::squareIndex({0, 4}));
+    EXPECT_FALSE(move.empty());
+    EXPECT_EQ(move.origin(), (Position{0, 0}));
+    EXPECT_EQ(move.destination(), (Position{0, 4}));
+    EXPECT_EQ(move.path(), (Path{{0, 0}, {2, 2}, {0, 4}}));
+}
+
+TEST(GameController, RemovingLastLandingShouldRestorePreviousMove)
+{
+    auto move = Move::startingAt(bitboard::squareIndex({0, 0}));
+    move.addLanding(bitboard::squareIndex({2, 2}));
+    const auto previousMove = move;
+    move.addLanding(bitboard::squareIndex({0, 4}));
+    move.removeLastLanding();
+    EXPECT_EQ(move, previousMove);
+    move.removeLastLanding();
+    EXPECT_EQ(move, Move::startingAt(bitboard::squareIndex({0, 0})));
+}
+
+TEST(GameController, MoveBufferOverloadFillsSameMovesAsMoveList)
+{
+    GameState state;
+    GameController controller(state);
+    MoveBuffer moveBuffer;
+    moveBuffer.push_back(Move::startingAt(0));
+    controller.getMoveList(FigureColor::White, moveBuffer);
+    const auto moveList = controller.getMoveList(FigureColor::White);
+    ASSERT_EQ(moveBuffer.size(), moveList.size());
+    EXPECT_TRUE(std::equal(moveBuffer.begin(), moveBuffer.end(), moveList.begin()));
+}
+
+TEST(GameController, QuietMoveShouldBeLegalExactlyWhenMoveListHasIt)
+{
+    //    7--------
+    //    6--o-----
+    //    5-----O--
+    //    4----x---
+    //    3---X----
+    //    2--o-----
+    //    1--------
+    //    0O-------
+    //     01234567
+    Board kingsBoard{};
+    kingsBoard[0][0] = FigureState{FigureType::King, FigureColor::White};
+    kingsBoard[2][2] = FigureState{FigureColor::White};
+    kingsBoard[6][2] = FigureState{FigureColor::White};
+    kingsBoard[5][5] = FigureState{FigureType::King, FigureColor::White};
+    kingsBoard[3][3] = FigureState{FigureType::King, FigureColor::Black};
+    kingsBoard[4][4] = FigureState{FigureType::Pawn, FigureColor::Black};
+    Board captureBoard{};
+    captureBoard[1][3] = FigureState{FigureColor::White};
+    captureBoard[2][2] = FigureState{FigureType::Pawn, FigureColor::Black};
+    for (const auto& gameState : {GameState{}, GameState{std::move(kingsBoard)}, GameState{std::move(captureBoard)}})
+    {
+        GameController controller(gameState);
+        for (const auto color : {FigureColor::White, FigureColor::Black})
+        {
+            const auto moveList = controller.getMoveList(color);
+            for (auto from = 0; from < DefaultRules::squaresNumber; from++)
+            {
+                for (auto to = 0; to < DefaultRules::squaresNumber; to++)
+                {
+                    const auto listed = std::find_if(moveList.begin(), moveList.end(), [from, to](const Move& move) {
+                        return move.from == from && move.to == to && move.captured == 0u;
+                    });
+                    const auto quietMove = controller.getQuietMove(color, from, to);
+                    ASSERT_EQ(quietMove.has_value(), listed != moveList.end()) << from << " " << to;
+                    if (quietMove)
+                    {
+                        EXPECT_EQ(*quietMove, *listed);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GameController, MoveBufferShouldThrowInsteadOfOverflowing)
+{
+    MoveBuffer moveBuffer;
+    for (std::size_t i = 0; i < MoveBuffer::capacity; i++)
+    {
+        moveBuffer.push_back(Move::startingAt(0));
+    }
+    EXPECT_THROW(moveBuffer.push_back(Move::startingAt(0)), std::length_error);
+    EXPECT_EQ(moveBuffer.size(), MoveBuffer::capacity);
+}
+
+namespace
+{
+template <typename Rules>
+std::uint64_t countLeaves(const BasicGameState<Rules>& gameState, FigureColor color, int depth)
+{
+    BasicMoveBuffer<Rules> moves;
+    BasicGameController<Rules>(gameState).getMoveList(color, moves);
+    if (depth == 1)
+    {
+        return moves.size();
+    }
+    std::uint64_t leaves = 0;
+    for (const auto& move : moves)
+    {
+        auto nextGameState = gameState;
+        nextGameState.makeMove(move);
+        leaves += countLeaves(nextGameState, FigureState::flipColor(color), depth - 1);
+    }
+    return leaves;
+}
+} // namespace
+
+TEST(GameController, InternationalRulesShouldMatchKnownPerftCounts)
+{
+    const BasicGameState<InternationalRules> gameState;
+    const std::array<std::uint64_t, 7> expectedLeaves{9, 81, 658, 4265, 27117, 167140, 1049442};
+    for (auto depth = 1; depth <= static_cast<int>(expectedLeaves.size()); depth++)
+    {
+        EXPECT_EQ(countLeaves(gameState, FigureColor::White, depth), expectedLeaves[depth - 1]) << depth;
+    }
+}
+
+TEST(GameController, InternationalKingShouldFlyAcrossWholeDiagonal)
+{
+    BasicBoard<InternationalRules> board{};
+    board[0][0] = FigureState{FigureType::King, FigureColor::White};
+    board[9][1] = FigureState{FigureColor::Black};
+    const BasicGameState<InternationalRules> gameState{std::move(board)};
+    const auto moves = BasicGameController<InternationalRules>(gameState).getMoveList(FigureColor::White);
+    ASSERT_EQ(moves.size(), 9);
+    EXPECT_EQ(moves.back().destination(), (Position{9, 9}));
+}
+
+namespace
+{
+template <typename Rules>
+void expectQueriesMatchMoveList(const BasicGameState<Rules>& gameState, FigureColor color)
+{
+    const BasicGameController<Rules> controller(gameState);
+    const auto moves = controller.getMoveList(color);
+    typename Rules::Bitboard pawnOrigins = 0u;
+    typename Rules::Bitboard kingOrigins = 0u;
+    for (const auto& move : moves)
+    {
+        const auto origin = bitboard::squareMask<Rules>(move.from);
+        ((gameState.kings() & origin) != 0u ? kingOrigins : pawnOrigins) |= origin;
+    }
+    EXPECT_EQ(controller.hasAnyMove(color), !moves.empty());
+    EXPECT_EQ(controller.countMoves(color), static_cast<int>(moves.size()));
+    EXPECT_EQ(controller.movablePiecesMask(color, FigureType::Pawn), pawnOrigins);
+    EXPECT_EQ(controller.movablePiecesMask(color, FigureType::King), kingOrigins);
+}
+
+template <typename Rules>
+void expectQueriesMatchMoveListInRandomGames()
+{
+    std::mt19937 generator{11};
+    for (auto game = 0; game < 50; game++)
+    {
+        BasicGameState<Rules> gameState;
+        auto color = FigureColor::White;
+        for (auto ply = 0; ply < 120; ply++)
+        {
+            expectQueriesMatchMoveList(gameState, color);
+            expectQueriesMatchMoveList(gameState, FigureState::flipColor(color));
+            const auto moves = BasicGameController<Rules>(gameState).getMoveList(color);
+            if (moves.empty())
+            {
+                break;
+            }
+            gameState.makeMove(moves[generator() % moves.size()]);
+            color = FigureState::flipColor(color);
+        }
+    }
+}
+} // namespace
+
+TEST(GameController, MoveQueriesShouldMatchGeneratedMoves)
+{
+    expectQueriesMatchMoveListInRandomGames<BrazilianRules>();
+    expectQueriesMatchMoveListInRandomGames<InternationalRules>();
+}
+
+TEST(GameController, MoveQueriesShouldReportBlockedSide)
+{
+    Board board;
+    board[0][0] = FigureState{FigureColor::White};
+    board[1][1] = FigureState{FigureColor::Black};
+    board[2][2] = FigureState{FigureColor::Black};
+    GameState state{std::move(board)};
+    GameController controller(state);
+    EXPECT_FALSE(controller.hasAnyMove(FigureColor::White));
+    EXPECT_EQ(controller.countMoves(FigureColor::White), 0);
+    EXPECT_EQ(controller.movablePiecesMask(FigureColor::White, FigureType::Pawn), bitboard::empty);
+    EXPECT_EQ(controller.gameResult(FigureColor::White), GameResult::BlackWin);
 }
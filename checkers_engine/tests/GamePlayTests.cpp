@@ -1,22 +1,41 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include "GamePlay.hpp"
 
 namespace
 {
-const auto chooseFirstMoveStrategy = [](const InitialGameState&,
-                                        const std::vector<GameStateWithMove>& gameStatesWithMove) {
-    return gameStatesWithMove.front();
+const auto chooseFirstMoveStrategy = [](const InitialGameState&, const PossibleMoves&, const PositionHistory&) {
+    return MoveIndex{0};
 };
+
+MoveIndex indexOf(const PossibleMoves& gameStatesWithMove, const GameState& gameState)
+{
+    const auto found = std::find_if(
+        gameStatesWithMove.begin(), gameStatesWithMove.end(), [&gameState](const GameStateWithMove& possibleMove) {
+            return possibleMove.gameState == gameState;
+        });
+    return static_cast<MoveIndex>(std::distance(gameStatesWithMove.begin(), found));
+}
+
+// Black king walks a cycle of three squares. Together with a white king shuffling between two squares the whole
+// position repeats only every twelve plies, so no-capture draws are reached before any threefold repetition.
+Position nextOnBlackKingCycle(Position position)
+{
+    const std::array<std::pair<Position, Position>, 6> cycle{
+        {{{7, 1}, {6, 2}}, {{6, 2}, {5, 3}}, {{5, 3}, {7, 1}}, {{1, 7}, {2, 6}}, {{2, 6}, {3, 5}}, {{3, 5}, {1, 7}}}};
+    return std::find_if(cycle.begin(), cycle.end(), [position](const auto& step) { return step.first == position; })
+        ->second;
 }
+} // namespace
 
 TEST(GamePlay, ShouldThrowWhenWhiteMoveNotAllowed)
 {
     GameState gameState;
-    GameState invalidGameState;
     GamePlay gamePlay{gameState,
-                      [invalidGameState](const InitialGameState&, const std::vector<GameStateWithMove>&) {
-                          return GameStateWithMove{invalidGameState, Move{}};
+                      [](const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
+                          return gameStatesWithMove.size();
                       },
                       chooseFirstMoveStrategy};
     EXPECT_THROW(gamePlay.start(), std::runtime_error);
@@ -25,11 +44,10 @@ TEST(GamePlay, ShouldThrowWhenWhiteMoveNotAllowed)
 TEST(GamePlay, ShouldThrowWhenBlackMoveNotAllowed)
 {
     GameState gameState;
-    GameState invalidGameState;
     GamePlay gamePlay{gameState,
                       chooseFirstMoveStrategy,
-                      [invalidGameState](const InitialGameState&, const std::vector<GameStateWithMove>&) {
-                          return GameStateWithMove{invalidGameState, Move{}};
+                      [](const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
+                          return gameStatesWithMove.size();
                       }};
     EXPECT_THROW(gamePlay.start(), std::runtime_error);
 }
@@ -61,19 +79,25 @@ TEST(GamePlay, ShouldInterchangePlayersMoves)
 
     const auto chooseFirstMoveStrategyWithMoveCheckWhite =
         [&whiteMove, &gameState](
-            const InitialGameState& initialGameState, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+            const InitialGameState& initialGameState,
+            const PossibleMoves& gameStatesWithMove,
+            const PositionHistory& gameHistory) {
             EXPECT_TRUE(whiteMove);
             EXPECT_EQ(gameState, initialGameState);
+            EXPECT_EQ(gameHistory.occurrences(gameState.hash(FigureColor::White)), 1);
             whiteMove = false;
-            return chooseFirstMoveStrategy(gameState, gameStatesWithMove);
+            return chooseFirstMoveStrategy(gameState, gameStatesWithMove, gameHistory);
         };
     const auto chooseFirstMoveStrategyWithMoveCheckBlack =
         [&whiteMove, &gameState](
-            const InitialGameState& initialGameState, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+            const InitialGameState& initialGameState,
+            const PossibleMoves& gameStatesWithMove,
+            const PositionHistory& gameHistory) {
             EXPECT_FALSE(whiteMove);
             EXPECT_EQ(gameState, initialGameState);
+            EXPECT_EQ(gameHistory.occurrences(gameState.hash(FigureColor::Black)), 1);
             whiteMove = true;
-            return chooseFirstMoveStrategy(gameState, gameStatesWithMove);
+            return chooseFirstMoveStrategy(gameState, gameStatesWithMove, gameHistory);
         };
     GamePlay gamePlay{gameState, chooseFirstMoveStrategyWithMoveCheckWhite, chooseFirstMoveStrategyWithMoveCheckBlack};
     gamePlay.start();
@@ -86,13 +110,55 @@ TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20)
     board[1][1] = FigureState{FigureType::King, FigureColor::White};
     board[7][1] = FigureState{FigureType::King, FigureColor::Black};
 
+    GameState inGameGameState{std::move(board)};
+    Position blackKing{7, 1};
+    const auto goToCornerEndlessStrategyWhite =
+        [&numberOfMoves,
+         &inGameGameState](const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
+            numberOfMoves++;
+
+            const auto startPosition = gameStatesWithMove.front().move.origin();
+            if (startPosition == Position{0, 0})
+            {
+                inGameGameState.movePawn({0, 0}, {1, 1});
+            }
+            else
+            {
+                inGameGameState.movePawn({1, 1}, {0, 0});
+            }
+            return indexOf(gameStatesWithMove, inGameGameState);
+        };
+    const auto walkCycleEndlessStrategyBlack =
+        [&numberOfMoves, &inGameGameState, &blackKing](
+            const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
+            numberOfMoves++;
+
+            const auto nextPosition = nextOnBlackKingCycle(blackKing);
+            inGameGameState.movePawn(blackKing, nextPosition);
+            blackKing = nextPosition;
+            return indexOf(gameStatesWithMove, inGameGameState);
+        };
+
+    GameState gameState = inGameGameState;
+    GamePlay gamePlay{gameState, goToCornerEndlessStrategyWhite, walkCycleEndlessStrategyBlack};
+    EXPECT_EQ(gamePlay.start(), GameResult::Draw);
+    EXPECT_EQ(numberOfMoves, 20);
+}
+
+TEST(GamePlay, ShouldDrawOnThreefoldRepetition)
+{
+    int numberOfMoves = 0;
+    Board board{};
+    board[1][1] = FigureState{FigureType::King, FigureColor::White};
+    board[7][1] = FigureState{FigureType::King, FigureColor::Black};
+
     GameState inGameGameState{std::move(board)};
     const auto goToCornerEndlessStrategyWhite =
         [&numberOfMoves,
-         &inGameGameState](const InitialGameState&, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+         &inGameGameState](const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
             numberOfMoves++;
 
-            const auto startPosition = gameStatesWithMove.front().move.front();
+            const auto startPosition = gameStatesWithMove.front().move.origin();
             if (startPosition == Position{0, 0})
             {
                 inGameGameState.movePawn({0, 0}, {1, 1});
@@ -101,14 +167,14 @@ TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20)
             {
                 inGameGameState.movePawn({1, 1}, {0, 0});
             }
-            return GameStateWithMove{inGameGameState, Move{}};
+            return indexOf(gameStatesWithMove, inGameGameState);
         };
     const auto goToCornerEndlessStrategyBlack =
         [&numberOfMoves,
-         &inGameGameState](const InitialGameState&, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+         &inGameGameState](const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
             numberOfMoves++;
 
-            const auto startPosition = gameStatesWithMove.front().move.front();
+            const auto startPosition = gameStatesWithMove.front().move.origin();
             if (startPosition == Position{1, 7})
             {
                 inGameGameState.movePawn({1, 7}, {7, 1});
@@ -117,13 +183,13 @@ TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20)
             {
                 inGameGameState.movePawn({7, 1}, {1, 7});
             }
-            return GameStateWithMove{inGameGameState, Move{}};
+            return indexOf(gameStatesWithMove, inGameGameState);
         };
 
     GameState gameState = inGameGameState;
     GamePlay gamePlay{gameState, goToCornerEndlessStrategyWhite, goToCornerEndlessStrategyBlack};
     EXPECT_EQ(gamePlay.start(), GameResult::Draw);
-    EXPECT_EQ(numberOfMoves, 20);
+    EXPECT_EQ(numberOfMoves, 8);
 }
 
 TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20WithResetCounterAfterWhitePawnBeaten)
@@ -135,16 +201,17 @@ TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20WithResetCounterAf
     board[7][1] = FigureState{FigureType::King, FigureColor::Black};
 
     GameState inGameGameState{std::move(board)};
+    Position blackKing{7, 1};
     const auto goToCornerEndlessStrategyWhite =
         [&numberOfMoves,
-         &inGameGameState](const InitialGameState&, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+         &inGameGameState](const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
             numberOfMoves++;
             if (numberOfMoves == 9)
             {
                 inGameGameState.movePawn({1, 5}, {2, 6});
-                return GameStateWithMove{inGameGameState, Move{}};
+                return indexOf(gameStatesWithMove, inGameGameState);
             }
-            const auto startPosition = gameStatesWithMove.front().move.front();
+            const auto startPosition = gameStatesWithMove.front().move.origin();
             if (startPosition == Position{0, 0})
             {
                 inGameGameState.movePawn({0, 0}, {1, 1});
@@ -153,32 +220,27 @@ TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20WithResetCounterAf
             {
                 inGameGameState.movePawn({1, 1}, {0, 0});
             }
-            return GameStateWithMove{inGameGameState, Move{}};
+            return indexOf(gameStatesWithMove, inGameGameState);
         };
-    const auto goToCornerEndlessStrategyBlack =
-        [&numberOfMoves,
-         &inGameGameState](const InitialGameState&, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+    const auto walkCycleEndlessStrategyBlack =
+        [&numberOfMoves, &inGameGameState, &blackKing](
+            const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
             numberOfMoves++;
-
-            const auto startPosition = gameStatesWithMove.front().move.front();
-            if (startPosition == Position{1, 7})
-            {
-                inGameGameState.movePawn({1, 7}, {7, 1});
-            }
-            else
-            {
-                inGameGameState.movePawn({7, 1}, {1, 7});
-            }
             if (numberOfMoves == 10)
             {
+                inGameGameState.movePawn(blackKing, {1, 7});
                 inGameGameState.removePawn({2, 6});
-                return GameStateWithMove{inGameGameState, Move{}};
+                blackKing = {1, 7};
+                return indexOf(gameStatesWithMove, inGameGameState);
             }
-            return GameStateWithMove{inGameGameState, Move{}};
+            const auto nextPosition = nextOnBlackKingCycle(blackKing);
+            inGameGameState.movePawn(blackKing, nextPosition);
+            blackKing = nextPosition;
+            return indexOf(gameStatesWithMove, inGameGameState);
         };
 
     GameState gameState = inGameGameState;
-    GamePlay gamePlay{gameState, goToCornerEndlessStrategyWhite, goToCornerEndlessStrategyBlack};
+    GamePlay gamePlay{gameState, goToCornerEndlessStrategyWhite, walkCycleEndlessStrategyBlack};
     EXPECT_EQ(gamePlay.start(), GameResult::Draw);
     EXPECT_EQ(numberOfMoves, 30);
 }
@@ -192,11 +254,12 @@ TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20WithResetCounterAf
     board[7][1] = FigureState{FigureType::King, FigureColor::Black};
 
     GameState inGameGameState{std::move(board)};
+    Position blackKing{7, 1};
     const auto goToCornerEndlessStrategyWhite =
         [&numberOfMoves,
-         &inGameGameState](const InitialGameState&, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+         &inGameGameState](const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
             numberOfMoves++;
-            const auto startPosition = gameStatesWithMove.front().move.front();
+            const auto startPosition = gameStatesWithMove.front().move.origin();
             if (startPosition == Position{7, 7})
             {
                 inGameGameState.movePawn({7, 7}, {1, 1});
@@ -208,33 +271,27 @@ TEST(GamePlay, ShouldDrawWhenNumberOfMovesWithNoBeatsExeedes20WithResetCounterAf
             if (numberOfMoves == 11)
             {
                 inGameGameState.removePawn({3, 3});
-                return GameStateWithMove{inGameGameState, Move{}};
+                return indexOf(gameStatesWithMove, inGameGameState);
             }
-            return GameStateWithMove{inGameGameState, Move{}};
+            return indexOf(gameStatesWithMove, inGameGameState);
         };
-    const auto goToCornerEndlessStrategyBlack =
-        [&numberOfMoves,
-         &inGameGameState](const InitialGameState&, const std::vector<GameStateWithMove>& gameStatesWithMove) {
+    const auto walkCycleEndlessStrategyBlack =
+        [&numberOfMoves, &inGameGameState, &blackKing](
+            const InitialGameState&, const PossibleMoves& gameStatesWithMove, const PositionHistory&) {
             numberOfMoves++;
             if (numberOfMoves == 10)
             {
                 inGameGameState.movePawn({4, 2}, {3, 3});
-                return GameStateWithMove{inGameGameState, Move{}};
-            }
-            const auto startPosition = gameStatesWithMove.front().move.front();
-            if (startPosition == Position{1, 7})
-            {
-                inGameGameState.movePawn({1, 7}, {7, 1});
+                return indexOf(gameStatesWithMove, inGameGameState);
             }
-            else
-            {
-                inGameGameState.movePawn({7, 1}, {1, 7});
-            }
-            return GameStateWithMove{inGameGameState, Move{}};
+            const auto nextPosition = nextOnBlackKingCycle(blackKing);
+            inGameGameState.movePawn(blackKing, nextPosition);
+            blackKing = nextPosition;
+            return indexOf(gameStatesWithMove, inGameGameState);
         };
 
     GameState gameState = inGameGameState;
-    GamePlay gamePlay{gameState, goToCornerEndlessStrategyWhite, goToCornerEndlessStrategyBlack};
+    GamePlay gamePlay{gameState, goToCornerEndlessStrategyWhite, walkCycleEndlessStrategyBlack};
     EXPECT_EQ(gamePlay.start(), GameResult::Draw);
     EXPECT_EQ(numberOfMoves, 31);
 }
@@ -116,3 +116,196 @@ TEST(GameState, isValidPosition)
     EXPECT_FALSE(GameState::isValid({7, 0}));
     EXPECT_FALSE(GameState::isValid({5, 4}));
 }
+
+TEST(GameState, ShouldKeepFiguresAsBitboards)
+{
+    GameState state;
+    EXPECT_EQ(state.figures(FigureColor::White), 0x00000FFFu);
+    EXPECT_EQ(state.figures(FigureColor::Black), 0xFFF00000u);
+    EXPECT_EQ(state.kings(), 0u);
+    EXPECT_EQ(state.occupied(), 0xFFF00FFFu);
+
+    state.changePawnType({2, 6}, FigureType::King);
+    EXPECT_EQ(state.kings(), bitboard::squareMask(Position{2, 6}));
+    state.movePawn({2, 6}, {3, 7});
+    EXPECT_EQ(state.kings(), bitboard::squareMask(Position{3, 7}));
+    EXPECT_EQ(state.pawnAtPosition({3, 7}).type, FigureType::King);
+    EXPECT_EQ(state, GameState(0x000087FFu, 0xFFF00000u, bitboard::squareMask(Position{3, 7})));
+}
+
+TEST(GameState, ShouldIgnoreFiguresOnNonPlayableSquares)
+{
+    Board board{};
+    board[0][1] = FigureState{FigureColor::White};
+    board[1][1] = FigureState{FigureType::King, FigureColor::Black};
+    GameState state{std::move(board)};
+    EXPECT_TRUE(state.isFree({0, 1}));
+    EXPECT_TRUE(state.pawns(FigureColor::White).empty());
+    ASSERT_EQ(state.pawns(FigureColor::Black).size(), 1);
+    EXPECT_EQ(state.pawns(FigureColor::Black).front().position, (Position{1, 1}));
+    EXPECT_EQ(state.pawns(FigureColor::Black).front().state.type, FigureType::King);
+}
+
+TEST(GameState, ShouldMakeAndUnmakeJumpWithPromotion)
+{
+    Board board{};
+    board[5][1] = FigureState{FigureColor::White};
+    board[6][2] = FigureState{FigureType::King, FigureColor::Black};
+    GameState state{std::move(board)};
+    const auto initialState = state;
+
+    auto jump = Move::startingAt(bitboard::squareIndex({5, 1}));
+    jump.addLanding(bitboard::squareIndex({7, 3}));
+    jump.captured = bitboard::squareMask(Position{6, 2});
+    jump.promotion = true;
+    const auto undoRecord = state.makeMove(jump);
+    EXPECT_TRUE(state.isFree({5, 1}));
+    EXPECT_TRUE(state.isFree({6, 2}));
+    EXPECT_EQ(state.pawnAtPosition({7, 3}).color, FigureColor::White);
+    EXPECT_EQ(state.pawnAtPosition({7, 3}).type, FigureType::King);
+    EXPECT_TRUE(state.pawns(FigureColor::Black).empty());
+
+    state.unmakeMove(jump, undoRecord);
+    EXPECT_EQ(state, initialState);
+    EXPECT_EQ(state.pawnAtPosition({6, 2}).type, FigureType::King);
+}
+
+TEST(GameState, ShouldMakeAndUnmakeKingMove)
+{
+    Board board{};
+    board[0][0] = FigureState{FigureType::King, FigureColor::White};
+    GameState state{std::move(board)};
+    const auto initialState = state;
+
+    auto move = Move::startingAt(bitboard::squareIndex({0, 0}));
+    move.addLanding(bitboard::squareIndex({4, 4}));
+    const auto undoRecord = state.makeMove(move);
+    EXPECT_TRUE(state.isFree({0, 0}));
+    EXPECT_EQ(state.pawnAtPosition({4, 4}).type, FigureType::King);
+
+    state.unmakeMove(move, undoRecord);
+    EXPECT_EQ(state, initialState);
+}
+
+TEST(GameState, HashShouldFollowEveryChangeOfPosition)
+{
+    GameState state;
+    const auto initialHash = state.hash(FigureColor::White);
+    EXPECT_NE(initialHash, state.hash(FigureColor::Black));
+
+    state.movePawn({2, 2}, {3, 3});
+    state.changePawnType({3, 3}, FigureType::King);
+    state.removePawn({5, 5});
+    const GameState sameState{state.figures(FigureColor::White), state.figures(FigureColor::Black), state.kings()};
+    EXPECT_EQ(state.hash(FigureColor::White), sameState.hash(FigureColor::White));
+    EXPECT_NE(state.hash(FigureColor::White), initialHash);
+
+    GameState otherState;
+    otherState.removePawn({5, 5});
+    otherState.movePawn({2, 2}, {3, 3});
+    EXPECT_NE(state.hash(FigureColor::White), otherState.hash(FigureColor::White));
+    state.changePawnType({3, 3}, FigureType::Pawn);
+    EXPECT_EQ(state.hash(FigureColor::White), otherState.hash(FigureColor::White));
+    state.movePawn({3, 3}, {2, 2});
+    EXPECT_NE(state.hash(FigureColor::White), otherState.hash(FigureColor::White));
+}
+
+TEST(GameState, MakeAndUnmakeShouldKeepHashUpToDate)
+{
+    Board board{};
+    board[5][1] = FigureState{FigureColor::White};
+    board[6][2] = FigureState{FigureType::King, FigureColor::Black};
+    board[4][4] = FigureState{FigureType::Pawn, FigureColor::Black};
+    GameState state{std::move(board)};
+    const auto initialHash = state.hash(FigureColor::White);
+
+    auto jump = Move::startingAt(bitboard::squareIndex({5, 1}));
+    jump.addLanding(bitboard::squareIndex({7, 3}));
+    jump.captured = bitboard::squareMask(Position{6, 2});
+    jump.promotion = true;
+    const auto undoRecord = state.makeMove(jump);
+    const GameState expectedState{state.figures(FigureColor::White), state.figures(FigureColor::Black), state.kings()};
+    EXPECT_EQ(state.hash(FigureColor::Black), expectedState.hash(FigureColor::Black));
+
+    state.unmakeMove(jump, undoRecord);
+    EXPECT_EQ(state.hash(FigureColor::White), initialHash);
+}
+
+TEST(GameState, MirroredPositionShouldShareCanonicalFormAndHash)
+{
+    Board board{};
+    board[0][0] = FigureState{FigureColor::White};
+    board[2][4] = FigureState{FigureType::King, FigureColor::White};
+    board[5][3] = FigureState{FigureColor::Black};
+    GameState state{std::move(board)};
+
+    const auto mirror = state.mirrored();
+    EXPECT_EQ(mirror.pawnAtPosition({7, 7}).color, FigureColor::Black);
+    EXPECT_EQ(mirror.pawnAtPosition({5, 3}).type, FigureType::King);
+    EXPECT_EQ(mirror.pawnAtPosition({2, 4}).color, FigureColor::White);
+    EXPECT_EQ(mirror.figuresNumber(FigureColor::Black), 2);
+    EXPECT_EQ(mirror.mirrored(), state);
+    const GameState rebuiltMirror{
+        mirror.figures(FigureColor::White), mirror.figures(FigureColor::Black), mirror.kings()};
+    EXPECT_EQ(mirror, rebuiltMirror);
+
+    EXPECT_FALSE(state.isSymmetric());
+    EXPECT_NE(state.isCanonical(), mirror.isCanonical());
+    EXPECT_EQ(state.canonical(), mirror.canonical());
+    EXPECT_TRUE(state.canonical().isCanonical());
+    EXPECT_EQ(state.canonicalHash(FigureColor::White), mirror.canonicalHash(FigureColor::Black));
+    EXPECT_EQ(state.canonicalHash(FigureColor::Black), mirror.canonicalHash(FigureColor::White));
+    EXPECT_NE(state.canonicalHash(FigureColor::White), state.canonicalHash(FigureColor::Black));
+    const auto canonicalSide = state.isCanonical() ? FigureColor::White : FigureColor::Black;
+    EXPECT_EQ(state.canonicalHash(FigureColor::White), state.canonical().hash(canonicalSide));
+}
+
+TEST(GameState, SymmetricPositionShouldBeItsOwnCanonicalForm)
+{
+    GameState state;
+    EXPECT_EQ(state.mirrored(), state);
+    EXPECT_TRUE(state.isCanonical());
+    EXPECT_TRUE(state.isSymmetric());
+    EXPECT_EQ(state.canonicalHash(FigureColor::White), state.hash(FigureColor::White));
+    EXPECT_EQ(state.canonicalHash(FigureColor::White), state.canonicalHash(FigureColor::Black));
+}
+
+TEST(GameState, InternationalInitialPositionShouldFillFourRowsPerSide)
+{
+    const BasicGameState<InternationalRules> state;
+    EXPECT_EQ(state.figuresNumber(FigureColor::White), 20);
+    EXPECT_EQ(state.figuresNumber(FigureColor::Black), 20);
+    EXPECT_EQ(state.pawnAtPosition({3, 9}).color, FigureColor::White);
+    EXPECT_EQ(state.pawnAtPosition({6, 0}).color, FigureColor::Black);
+    EXPECT_TRUE(state.isFree({4, 4}));
+    EXPECT_TRUE(state.isFree({5, 5}));
+    EXPECT_EQ(state.mirrored(), state);
+}
+
+TEST(GameState, ShouldCountAndViewFiguresWithoutScanningBoard)
+{
+    GameState state;
+    EXPECT_EQ(state.figuresNumber(FigureColor::White), 12);
+    EXPECT_EQ(state.figuresNumber(FigureColor::Black), 12);
+    EXPECT_EQ(state.kingsNumber(FigureColor::White), 0);
+
+    state.removePawn({5, 1});
+    state.changePawnType({0, 0}, FigureType::King);
+    EXPECT_EQ(state.figuresNumber(FigureColor::Black), 11);
+    EXPECT_EQ(state.kingsNumber(FigureColor::White), 1);
+
+    const auto view = state.figuresView(FigureColor::White);
+    EXPECT_EQ(view.size(), 12);
+    EXPECT_EQ(view.kingsNumber(), 1);
+    EXPECT_EQ(view.pawnsNumber(), 11);
+    const auto pawns = state.pawns(FigureColor::White);
+    ASSERT_EQ(std::distance(view.begin(), view.end()), static_cast<std::ptrdiff_t>(pawns.size()));
+    auto pawn = pawns.begin();
+    for (const auto& figure : view)
+    {
+        EXPECT_EQ(figure.position, pawn->position);
+        EXPECT_EQ(figure.state, pawn->state);
+        ++pawn;
+    }
+    EXPECT_EQ((*view.begin()).state.type, FigureType::King);
+}
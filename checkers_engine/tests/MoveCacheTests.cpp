@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <random>
+
+#include "MoveCache.hpp"
+
+namespace
+{
+template <typename Rules>
+void expectSameMoveLists(BasicMoveCache<Rules>& moveCache, const BasicGameState<Rules>& gameState, FigureColor color)
+{
+    BasicMoveBuffer<Rules> cachedMoves;
+    moveCache.getMoveList(color, cachedMoves);
+    const auto moves = BasicGameController<Rules>(gameState).getMoveList(color);
+    ASSERT_EQ(cachedMoves.size(), moves.size());
+    EXPECT_TRUE(std::equal(cachedMoves.begin(), cachedMoves.end(), moves.begin()));
+}
+
+// Plays random games, and before every move also makes and takes back each of the alternatives, so the cache is
+// checked after unmakeMove as well as after makeMove.
+template <typename Rules>
+void expectCacheToFollowRandomGames()
+{
+    std::mt19937 generator{3};
+    for (auto game = 0; game < 20; game++)
+    {
+        BasicGameState<Rules> gameState;
+        BasicMoveCache<Rules> moveCache(gameState);
+        auto color = FigureColor::White;
+        for (auto ply = 0; ply < 150; ply++)
+        {
+            const auto moves = BasicGameController<Rules>(gameState).getMoveList(color);
+            if (moves.empty())
+            {
+                break;
+            }
+            for (const auto& move : moves)
+            {
+                const auto undoRecord = gameState.makeMove(move);
+                moveCache.update(move);
+                expectSameMoveLists(moveCache, gameState, FigureState::flipColor(color));
+                gameState.unmakeMove(move, undoRecord);
+                moveCache.update(move);
+                expectSameMoveLists(moveCache, gameState, color);
+            }
+            const auto& move = moves[generator() % moves.size()];
+            gameState.makeMove(move);
+            moveCache.update(move);
+            color = FigureState::flipColor(color);
+        }
+    }
+}
+} // namespace
+
+TEST(MoveCache, ShouldListSameMovesAsGameControllerAcrossMakeAndUnmake)
+{
+    expectCacheToFollowRandomGames<BrazilianRules>();
+    expectCacheToFollowRandomGames<InternationalRules>();
+}
+
+TEST(MoveCache, ShouldFollowKingSlidingAwayFromBlockedKing)
+{
+    //    2--k----
+    //    1-K-----
+    //    0K------
+    //     0123456
+    Board board{};
+    board[0][0] = FigureState{FigureType::King, FigureColor::White};
+    board[1][1] = FigureState{FigureType::King, FigureColor::White};
+    board[2][2] = FigureState{FigureType::King, FigureColor::Black};
+    board[7][7] = FigureState{FigureType::King, FigureColor::Black};
+    GameState gameState{std::move(board)};
+    MoveCache moveCache(gameState);
+    expectSameMoveLists(moveCache, gameState, FigureColor::Black);
+
+    auto move = Move::startingAt(bitboard::squareIndex({2, 2}));
+    move.addLanding(bitboard::squareIndex({3, 1}));
+    gameState.makeMove(move);
+    moveCache.update(move);
+    expectSameMoveLists(moveCache, gameState, FigureColor::White);
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "MovePicker.hpp"
+
+namespace
+{
+MoveList pickAll(const GameState& gameState, FigureColor color, const MoveHints& hints = {})
+{
+    MoveList moves;
+    MovePicker movePicker(gameState, color, hints);
+    for (auto move = movePicker.nextMove(); move; move = movePicker.nextMove())
+    {
+        moves.push_back(*move);
+    }
+    return moves;
+}
+
+// A move as the transposition table keeps it, without its landings.
+Move stored(const Move& move)
+{
+    auto storedMove = Move::startingAt(move.from);
+    storedMove.to = move.to;
+    storedMove.captured = move.captured;
+    return storedMove;
+}
+} // namespace
+
+TEST(MovePicker, ShouldPickSameMovesAsMoveListInInitialPosition)
+{
+    GameState gameState;
+    GameController controller(gameState);
+    EXPECT_EQ(pickAll(gameState, FigureColor::White), controller.getMoveList(FigureColor::White));
+    EXPECT_EQ(pickAll(gameState, FigureColor::Black), controller.getMoveList(FigureColor::Black));
+}
+
+TEST(MovePicker, ShouldPickOnlyCapturesWhenAnyIsAvailable)
+{
+    //    5-----x
+    //    4------
+    //    3------
+    //    2--x-x-
+    //    1---o--
+    //    0------
+    //     012345
+    Board board{};
+    board[1][3] = FigureState{FigureColor::White};
+    board[2][2] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[2][4] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[5][5] = FigureState{FigureType::Pawn, FigureColor::Black};
+    GameState gameState(std::move(board));
+    const auto moves = pickAll(gameState, FigureColor::White);
+    ASSERT_EQ(moves.size(), 2);
+    EXPECT_NE(moves.at(0).captured, bitboard::empty);
+    EXPECT_NE(moves.at(1).captured, bitboard::empty);
+    EXPECT_EQ(moves, GameController(gameState).getMoveList(FigureColor::White));
+}
+
+TEST(MovePicker, ShouldPickPromotionsBeforeQuietMoves)
+{
+    //    7--------
+    //    6--o-----
+    //    5-----O--
+    //    4--------
+    //    3--------
+    //    2--o-----
+    //    1--------
+    //    0x-------
+    //     01234567
+    Board board{};
+    board[2][2] = FigureState{FigureColor::White};
+    board[6][2] = FigureState{FigureColor::White};
+    board[5][5] = FigureState{FigureType::King, FigureColor::White};
+    board[0][0] = FigureState{FigureType::Pawn, FigureColor::Black};
+    GameState gameState(std::move(board));
+    const auto moves = pickAll(gameState, FigureColor::White);
+    const auto moveList = GameController(gameState).getMoveList(FigureColor::White);
+    ASSERT_EQ(moves.size(), moveList.size());
+    EXPECT_TRUE(std::is_permutation(moves.begin(), moves.end(), moveList.begin()));
+
+    ASSERT_GE(moves.size(), 2);
+    EXPECT_TRUE(moves.at(0).promotion);
+    EXPECT_TRUE(moves.at(1).promotion);
+    EXPECT_EQ(moves.at(0).path(), (Path{{6, 2}, {7, 1}}));
+    EXPECT_EQ(moves.at(1).path(), (Path{{6, 2}, {7, 3}}));
+    EXPECT_TRUE(std::none_of(moves.begin() + 2, moves.end(), [](const Move& move) { return move.promotion; }));
+}
+
+TEST(MovePicker, ShouldContinueAfterGameStateWasMadeAndUnmade)
+{
+    GameState gameState;
+    const auto moveList = GameController(gameState).getMoveList(FigureColor::White);
+    MoveList moves;
+    MovePicker movePicker(gameState, FigureColor::White);
+    for (auto move = movePicker.nextMove(); move; move = movePicker.nextMove())
+    {
+        const auto undoRecord = gameState.makeMove(*move);
+        gameState.unmakeMove(*move, undoRecord);
+        moves.push_back(*move);
+    }
+    EXPECT_EQ(moves, moveList);
+    EXPECT_EQ(gameState, GameState{});
+}
+
+TEST(MovePicker, ShouldPickLegalHashMoveFirstAndOnlyOnce)
+{
+    GameState gameState;
+    const auto moveList = GameController(gameState).getMoveList(FigureColor::White);
+    MoveHints hints;
+    hints.hashMove = stored(moveList.back());
+
+    const auto moves = pickAll(gameState, FigureColor::White, hints);
+    ASSERT_EQ(moves.size(), moveList.size());
+    EXPECT_EQ(moves.front(), moveList.back());
+    EXPECT_TRUE(std::equal(moves.begin() + 1, moves.end(), moveList.begin()));
+}
+
+TEST(MovePicker, ShouldPickLegalKillersAfterHashMoveAndSkipIllegalOnes)
+{
+    GameState gameState;
+    const auto whiteMoves = GameController(gameState).getMoveList(FigureColor::White);
+    const auto blackMoves = GameController(gameState).getMoveList(FigureColor::Black);
+    MoveHints hints;
+    hints.hashMove = stored(blackMoves.front());
+    hints.killers = {blackMoves.back(), whiteMoves.at(2)};
+
+    const auto moves = pickAll(gameState, FigureColor::White, hints);
+    ASSERT_EQ(moves.size(), whiteMoves.size());
+    EXPECT_EQ(moves.front(), whiteMoves.at(2));
+    EXPECT_TRUE(std::is_permutation(moves.begin(), moves.end(), whiteMoves.begin()));
+}
+
+TEST(MovePicker, ShouldPickHashCaptureFirstAndIgnoreQuietHintsWhenCapturing)
+{
+    //    7-------x
+    //    6--------
+    //    5--------
+    //    4--------
+    //    3--------
+    //    2--x-x---
+    //    1---o----
+    //    0o-------
+    //     01234567
+    Board board{};
+    board[0][0] = FigureState{FigureColor::White};
+    board[1][3] = FigureState{FigureColor::White};
+    board[2][2] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[2][4] = FigureState{FigureType::Pawn, FigureColor::Black};
+    board[7][7] = FigureState{FigureType::Pawn, FigureColor::Black};
+    GameState gameState(std::move(board));
+    const auto moveList = GameController(gameState).getMoveList(FigureColor::White);
+    ASSERT_EQ(moveList.size(), 2);
+    MoveHints hints;
+    hints.hashMove = stored(moveList.back());
+    auto quietMove = Move::startingAt(bitboard::squareIndex({0, 0}));
+    quietMove.addLanding(bitboard::squareIndex({1, 1}));
+    hints.killers = {quietMove, std::nullopt};
+
+    const auto moves = pickAll(gameState, FigureColor::White, hints);
+    ASSERT_EQ(moves.size(), moveList.size());
+    EXPECT_EQ(moves.front(), moveList.back());
+    EXPECT_TRUE(std::is_permutation(moves.begin(), moves.end(), moveList.begin()));
+}
+
+TEST(MovePicker, ShouldPickQuietMovesByHistoryScore)
+{
+    GameState gameState;
+    const auto moveList = GameController(gameState).getMoveList(FigureColor::White);
+    ASSERT_GE(moveList.size(), 3);
+    MoveHistory history{};
+    history[moveList.at(2).from][moveList.at(2).to] = 5;
+    history[moveList.at(1).from][moveList.at(1).to] = 3;
+    MoveHints hints;
+    hints.history = &history;
+
+    const auto moves = pickAll(gameState, FigureColor::White, hints);
+    ASSERT_EQ(moves.size(), moveList.size());
+    EXPECT_EQ(moves.at(0), moveList.at(2));
+    EXPECT_EQ(moves.at(1), moveList.at(1));
+    EXPECT_EQ(moves.at(2), moveList.at(0));
+    EXPECT_TRUE(std::equal(moves.begin() + 3, moves.end(), moveList.begin() + 3));
+}
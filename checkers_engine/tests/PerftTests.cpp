@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <array>
+
+#include "Perft.hpp"
+
+namespace
+{
+constexpr std::array<std::uint64_t, 7> initialPositionNodes{1, 7, 49, 302, 1469, 7473, 37628};
+} // namespace
+
+TEST(Perft, ShouldCountNodesFromInitialPosition)
+{
+    const GameState gameState;
+    const Perft perft;
+    for (auto depth = 0u; depth < initialPositionNodes.size(); depth++)
+    {
+        EXPECT_EQ(perft.countNodes(gameState, FigureColor::White, depth), initialPositionNodes.at(depth));
+    }
+}
+
+TEST(Perft, ShouldCountSameNodesWithTranspositionHashing)
+{
+    const GameState gameState;
+    const Perft perft{{1, true}};
+    const auto depth = initialPositionNodes.size() - 1;
+    EXPECT_EQ(perft.countNodes(gameState, FigureColor::White, depth), initialPositionNodes.at(depth));
+    EXPECT_EQ(Perft({1, true, 10}).countNodes(gameState, FigureColor::White, depth), initialPositionNodes.at(depth));
+}
+
+TEST(Perft, ShouldCountSameNodesWhenRootMovesAreSplitAcrossThreads)
+{
+    const GameState gameState;
+    const auto depth = initialPositionNodes.size() - 1;
+    EXPECT_EQ(Perft({4, false}).countNodes(gameState, FigureColor::White, depth), initialPositionNodes.at(depth));
+    EXPECT_EQ(Perft({4, true}).countNodes(gameState, FigureColor::White, depth), initialPositionNodes.at(depth));
+}
+
+TEST(Perft, ShouldCountOnlyLegalJumps)
+{
+    GameState gameState{bitboard::squareMask(Position{2, 2}), bitboard::squareMask(Position{3, 3}), bitboard::empty};
+    const Perft perft;
+    EXPECT_EQ(perft.countNodes(gameState, FigureColor::White, 1), 1u);
+    EXPECT_EQ(perft.countNodes(gameState, FigureColor::White, 2), 0u);
+    EXPECT_EQ(perft.countNodes(gameState, FigureColor::Black, 1), 1u);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "PositionHistory.hpp"
+
+TEST(PositionHistory, ShouldCountOccurrencesSinceLastIrreversibleMove)
+{
+    PositionHistory history;
+    history.push(1, true);
+    history.push(2, false);
+    history.push(1, false);
+    EXPECT_EQ(history.occurrences(1), 2);
+    EXPECT_EQ(history.occurrences(2), 1);
+    EXPECT_EQ(history.occurrences(3), 0);
+
+    history.push(3, true);
+    history.push(1, false);
+    EXPECT_EQ(history.occurrences(1), 1);
+    EXPECT_EQ(history.occurrences(2), 0);
+
+    history.pop();
+    history.pop();
+    EXPECT_EQ(history.occurrences(1), 2);
+
+    history.clear();
+    EXPECT_EQ(history.occurrences(1), 0);
+}
+
+TEST(PositionHistory, OnlyKingMovesWithoutCaptureAreReversible)
+{
+    Board board{};
+    board[1][1] = FigureState{FigureType::King, FigureColor::White};
+    board[2][4] = FigureState{FigureType::Pawn, FigureColor::White};
+    board[3][5] = FigureState{FigureType::Pawn, FigureColor::Black};
+    GameState gameState{std::move(board)};
+
+    auto kingMove = Move::startingAt(bitboard::squareIndex({1, 1}));
+    kingMove.addLanding(bitboard::squareIndex({2, 2}));
+    EXPECT_FALSE(PositionHistory::isIrreversible(gameState, kingMove));
+
+    auto pawnMove = Move::startingAt(bitboard::squareIndex({2, 4}));
+    pawnMove.addLanding(bitboard::squareIndex({3, 3}));
+    EXPECT_TRUE(PositionHistory::isIrreversible(gameState, pawnMove));
+
+    auto pawnJump = Move::startingAt(bitboard::squareIndex({2, 4}));
+    pawnJump.addLanding(bitboard::squareIndex({4, 6}));
+    pawnJump.captured = bitboard::squareMask(Position{3, 5});
+    EXPECT_TRUE(PositionHistory::isIrreversible(gameState, pawnJump));
+}
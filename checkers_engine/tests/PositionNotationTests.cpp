@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "PositionNotation.hpp"
+
+TEST(PositionNotation, ShouldNumberSquaresFromBlackBackRow)
+{
+    EXPECT_EQ(notation::pdnSquare(bitboard::squareIndex({7, 1})), 1);
+    EXPECT_EQ(notation::pdnSquare(bitboard::squareIndex({7, 7})), 4);
+    EXPECT_EQ(notation::pdnSquare(bitboard::squareIndex({0, 0})), 29);
+    EXPECT_EQ(notation::pdnSquare(bitboard::squareIndex({0, 6})), 32);
+    for (int square = 0; square < bitboard::squaresNumber; square++)
+    {
+        EXPECT_EQ(notation::squareFromPdn(notation::pdnSquare(square)), square);
+    }
+}
+
+TEST(PositionNotation, PackedPositionShouldRoundTrip)
+{
+    Board board{};
+    board[0][0] = FigureState{FigureColor::White};
+    board[3][5] = FigureState{FigureType::King, FigureColor::White};
+    board[7][7] = FigureState{FigureType::King, FigureColor::Black};
+    const GameState gameState{std::move(board)};
+
+    const auto packedPosition = notation::pack(gameState);
+    EXPECT_EQ(packedPosition.size(), 12);
+    EXPECT_EQ(notation::unpack(packedPosition), gameState);
+    EXPECT_EQ(notation::unpack(notation::pack(GameState{})), GameState{});
+}
+
+TEST(PositionNotation, UnpackShouldRejectInconsistentBitboards)
+{
+    notation::PackedPosition overlappingColors{};
+    overlappingColors[0] = 1;
+    overlappingColors[4] = 1;
+    EXPECT_FALSE(notation::unpack(overlappingColors).has_value());
+
+    notation::PackedPosition kingOnEmptySquare{};
+    kingOnEmptySquare[8] = 1;
+    EXPECT_FALSE(notation::unpack(kingOnEmptySquare).has_value());
+
+    notation::PackedPosition tooManyFigures{};
+    tooManyFigures[4] = 0xff;
+    tooManyFigures[5] = 0x1f;
+    EXPECT_FALSE(notation::unpack(tooManyFigures).has_value());
+    tooManyFigures[5] = 0x0f;
+    EXPECT_TRUE(notation::unpack(tooManyFigures).has_value());
+}
+
+TEST(PositionNotation, InitialPositionShouldBeWrittenAsStandardFen)
+{
+    EXPECT_EQ(
+        notation::toFen(GameState{}, FigureColor::White),
+        "W:W21,22,23,24,25,26,27,28,29,30,31,32:B1,2,3,4,5,6,7,8,9,10,11,12");
+    const auto fenPosition = notation::fromFen("B:B1-12:W21-32.");
+    ASSERT_TRUE(fenPosition.has_value());
+    EXPECT_EQ(fenPosition->gameState, GameState{});
+    EXPECT_EQ(fenPosition->sideToMove, FigureColor::Black);
+}
+
+TEST(PositionNotation, FenShouldRoundTripKingsAndSideToMove)
+{
+    Board board{};
+    board[0][0] = FigureState{FigureColor::White};
+    board[4][4] = FigureState{FigureType::King, FigureColor::White};
+    board[6][2] = FigureState{FigureType::King, FigureColor::Black};
+    const GameState gameState{std::move(board)};
+
+    const auto fen = notation::toFen(gameState, FigureColor::Black);
+    EXPECT_EQ(fen, "B:WK15,29:BK6");
+    const auto fenPosition = notation::fromFen(fen);
+    ASSERT_TRUE(fenPosition.has_value());
+    EXPECT_EQ(fenPosition->gameState, gameState);
+    EXPECT_EQ(fenPosition->sideToMove, FigureColor::Black);
+
+    const auto withoutBlack = notation::fromFen("W:W29:B");
+    ASSERT_TRUE(withoutBlack.has_value());
+    EXPECT_EQ(withoutBlack->gameState.figuresNumber(FigureColor::Black), 0);
+}
+
+TEST(PositionNotation, FromFenShouldRejectMalformedInput)
+{
+    for (const auto* fen :
+         {"", "W", "X:W1:B2", "W:W1", "W:W1:W2", "W:W1:B1", "W:W0:B2", "W:W33:B2", "W:W5-2:B1", "W:W1,:B2", "W:W1:B2x"})
+    {
+        EXPECT_FALSE(notation::fromFen(fen).has_value()) << fen;
+    }
+}
+
+TEST(PositionNotation, FromFenShouldRejectSideWithMoreFiguresThanAtStart)
+{
+    // Thirteen black figures, which would let the white king capture more of them than a move can hold.
+    EXPECT_FALSE(notation::fromFen("W:WK1:B6,7,8,9,11,14,15,16,17,23,24,25,26").has_value());
+    EXPECT_FALSE(notation::fromFen("W:W1-13:B32").has_value());
+    EXPECT_TRUE(notation::fromFen("W:WK1:B6,7,8,9,11,14,15,16,17,23,24,25").has_value());
+}
+
+TEST(PositionNotation, MovesShouldRoundTripThroughPdn)
+{
+    Board board{};
+    board[2][2] = FigureState{FigureColor::White};
+    board[3][3] = FigureState{FigureColor::Black};
+    board[5][5] = FigureState{FigureColor::Black};
+    board[0][6] = FigureState{FigureColor::White};
+    const GameState gameState{std::move(board)};
+    const auto jumps = GameController(gameState).getMoveList(FigureColor::White);
+    ASSERT_EQ(jumps.size(), 1);
+
+    const auto pdn = notation::toPdn(jumps.front());
+    EXPECT_EQ(pdn, "22x15x8");
+    EXPECT_EQ(notation::moveFromPdn(pdn, jumps), jumps.front());
+    EXPECT_EQ(notation::moveFromPdn("22x8", jumps), jumps.front());
+    EXPECT_FALSE(notation::moveFromPdn("22-15", jumps).has_value());
+    EXPECT_FALSE(notation::moveFromPdn("22x15", jumps).has_value());
+
+    const auto quietMoves = GameController(GameState{}).getMoveList(FigureColor::White);
+    for (const auto& move : quietMoves)
+    {
+        EXPECT_EQ(notation::moveFromPdn(notation::toPdn(move), quietMoves), move);
+    }
+    EXPECT_EQ(notation::toPdn(quietMoves.front()), "21-17");
+}
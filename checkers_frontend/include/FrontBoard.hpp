@@ -41,7 +41,7 @@ public:
     const GameState& getGameState() const;
 
 signals:
-    void signalMoveDone(const Move&);
+    void signalMoveDone(const Path&);
 
 private:
     void drawPawn(FigureColor color, FigureType type, Position, int space, QPainter* painter);
@@ -50,7 +50,7 @@ private:
 
     Space getCurrentSpace() const;
 
-    Move m_dragMove;
+    Path m_dragMove;
 
     std::set<FigureColor> m_blockedPlayers;
 
@@ -23,7 +23,7 @@ private:
     void loadAI(const std::string& fileName);
 
     MoveDecisionCallback getHumanDecisionCallback();
-    Move lastHumanMove;
+    Path lastHumanMove;
 
     std::unique_ptr<GamePlay> gamePlay;
     GameState gameState;
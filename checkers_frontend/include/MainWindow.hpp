@@ -43,7 +43,7 @@ public:
     void pushInfo(const QString& info);
 signals:
 
-    void signalMoveDone(const Move&);
+    void signalMoveDone(const Path&);
     void signalStartNewGame();
     void signalLoadMetrics(const std::string&);
 
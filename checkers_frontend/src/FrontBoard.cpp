@@ -49,12 +49,12 @@ void FrontBoard::paintEvent(QPaintEvent* event)
         painter.drawLine(vLineBegin, vLineEnd);
     }
 
-    auto allPawns = m_temporaryDrawnState.pawns(FigureColor::White);
-    const auto blackPawns = m_temporaryDrawnState.pawns(FigureColor::Black);
-    allPawns.insert(allPawns.end(), blackPawns.begin(), blackPawns.end());
-    for (const auto& pawn : allPawns)
+    for (const auto color : {FigureColor::White, FigureColor::Black})
     {
-        drawPawn(pawn.state.color, pawn.state.type, pawn.position, space, &painter);
+        for (const auto& pawn : m_temporaryDrawnState.figuresView(color))
+        {
+            drawPawn(pawn.state.color, pawn.state.type, pawn.position, space, &painter);
+        }
     }
 
     for (int row = 0; row < boardSize; row++)
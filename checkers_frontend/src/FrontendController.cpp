@@ -1,16 +1,30 @@
 #include "FrontendController.hpp"
 #include <QApplication>
 #include <algorithm>
+#include <numeric>
 
 #include "Helpers.hpp"
 
 #include <QDebug>
-FrontendController::FrontendController() : mainWindow{gameState}
+namespace
+{
+// The AI searches up to the depth set in the GUI, but always answers within the time budget. Only one game is played,
+// so its table can be much larger than the default one.
+SearchOptions aiSearchOptions()
+{
+    SearchOptions options;
+    options.transpositionTableSize = 16u * 1024u * 1024u;
+    options.timeBudget = std::chrono::seconds{3};
+    return options;
+}
+} // namespace
+
+FrontendController::FrontendController() : mainWindow{gameState}, strategy{aiSearchOptions()}
 {
     mainWindow.show();
     mainWindow.blockPawnMoves(FigureColor::Black, true);
     mainWindow.blockPawnMoves(FigureColor::White, true);
-    QObject::connect(&mainWindow, &MainWindow::signalMoveDone, [this](const Move& move) {
+    QObject::connect(&mainWindow, &MainWindow::signalMoveDone, [this](const Path& move) {
         lastHumanMove = move;
         humanMovesEventLoop.quit();
     });
@@ -37,14 +51,17 @@ void FrontendController::startNewGame()
             break;
         case StrategyType::Ai:
             blackStrategyText.prepend("AI");
-            blackStrategy =
-                [this](const InitialGameState& initalGameState, const std::vector<GameStateWithMove>& possibleMoves) {
-                    if (ai)
-                    {
-                        return ai->getMove(initalGameState, FigureColor::Black);
-                    }
-                    return possibleMoves.front();
-                };
+            blackStrategy = [this](
+                                const InitialGameState& initalGameState,
+                                const PossibleMoves& possibleMoves,
+                                const PositionHistory& gameHistory) {
+                if (ai)
+                {
+                    return ai->getMove(initalGameState, possibleMoves, FigureColor::Black, gameHistory)
+                        .value_or(MoveIndex{0});
+                }
+                return MoveIndex{0};
+            };
             break;
     }
     switch (mainWindow.getWhiteStrategy())
@@ -56,14 +73,17 @@ void FrontendController::startNewGame()
             break;
         case StrategyType::Ai:
             whiteStrategyText.prepend("AI");
-            whiteStrategy =
-                [this](const InitialGameState& initalGameState, const std::vector<GameStateWithMove>& possibleMoves) {
-                    if (ai)
-                    {
-                        return ai->getMove(initalGameState, FigureColor::White);
-                    }
-                    return possibleMoves.front();
-                };
+            whiteStrategy = [this](
+                                const InitialGameState& initalGameState,
+                                const PossibleMoves& possibleMoves,
+                                const PositionHistory& gameHistory) {
+                if (ai)
+                {
+                    return ai->getMove(initalGameState, possibleMoves, FigureColor::White, gameHistory)
+                        .value_or(MoveIndex{0});
+                }
+                return MoveIndex{0};
+            };
             break;
     }
     mainWindow.pushInfo(QString("New game start:") + whiteStrategyText + QString(" vs ") + blackStrategyText);
@@ -107,12 +127,13 @@ void FrontendController::loadAI(const std::string& fileName)
 }
 MoveDecisionCallback FrontendController::getHumanDecisionCallback()
 {
-    return [this](const InitialGameState&, const std::vector<GameStateWithMove>& possibleMoves) {
+    return [this](const InitialGameState&, const PossibleMoves& possibleMoves, const PositionHistory&) {
         mainWindow.syncTemporaryState();
-        std::vector<GameStateWithMove> movesToCheck;
+        std::vector<MoveIndex> movesToCheck;
         while (true)
         {
-            movesToCheck = possibleMoves;
+            movesToCheck.resize(possibleMoves.size());
+            std::iota(movesToCheck.begin(), movesToCheck.end(), MoveIndex{0});
             do
             {
                 mainWindow.pushInfo("Waiting for human player to make a move...");
@@ -120,7 +141,7 @@ MoveDecisionCallback FrontendController::getHumanDecisionCallback()
                 if (humanMovesEventLoop.exec() != eventLoopSuccessExitCode)
                 {
                     gamePlay->stopGameplay();
-                    return possibleMoves.front();
+                    return MoveIndex{0};
                 }
                 for (uint jumpNumber = 0; jumpNumber < lastHumanMove.size(); jumpNumber++)
                 {
@@ -128,8 +149,9 @@ MoveDecisionCallback FrontendController::getHumanDecisionCallback()
                         std::remove_if(
                             movesToCheck.begin(),
                             movesToCheck.end(),
-                            [this, jumpNumber](const auto& gameStateWithMove) {
-                                return !(gameStateWithMove.move.at(jumpNumber) == lastHumanMove.at(jumpNumber));
+                            [this, &possibleMoves, jumpNumber](MoveIndex moveIndex) {
+                                const auto path = possibleMoves[moveIndex].move.path();
+                                return jumpNumber >= path.size() || !(path[jumpNumber] == lastHumanMove.at(jumpNumber));
                             }),
                         movesToCheck.end());
                 }
@@ -20,7 +20,7 @@ MainWindow::MainWindow(const GameState& gameState, QWidget* parent)
 
     frontBoard = std::make_unique<FrontBoard>(gameState);
 
-    connect(frontBoard.get(), &FrontBoard::signalMoveDone, [this](const Move& move) { emit signalMoveDone(move); });
+    connect(frontBoard.get(), &FrontBoard::signalMoveDone, [this](const Path& move) { emit signalMoveDone(move); });
 
     connect(ui->start, &QPushButton::clicked, [this]() { emit signalStartNewGame(); });
     ui->frontBoard->layout()->addWidget(frontBoard.get());
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "GameController.hpp"
+
+// One finished game. Moves are enough to replay it from the initial position.
+struct GameRecord
+{
+    unsigned int whitePlayerId{0};
+    unsigned int blackPlayerId{0};
+    unsigned int generation{0};
+    GameResult result{GameResult::GameOn};
+    MoveList moves;
+};
+
+// Append-only binary game log. Every record starts with its size as a varint, followed by varints of player ids and
+// generation, a result byte, a varint number of moves and the moves. A move is one byte with its origin square in the
+// lower five bits and the number of landings in the upper three (7 means the number follows in the next byte), then
+// the zigzag encoded difference of every landing from the previous square, one byte each.
+namespace gamelog
+{
+using Bytes = std::vector<std::uint8_t>;
+
+void encode(const GameRecord&, Bytes& bytes);
+} // namespace gamelog
+
+// Writes buffers handed over by any number of threads from a single background thread, so threads producing games
+// only contend on a short queue push.
+class GameLogWriter
+{
+public:
+    explicit GameLogWriter(std::ostream& output);
+    GameLogWriter(const GameLogWriter&) = delete;
+    GameLogWriter(GameLogWriter&&) = delete;
+    ~GameLogWriter();
+
+    GameLogWriter& operator=(const GameLogWriter&) = delete;
+    GameLogWriter& operator=(GameLogWriter&&) = delete;
+
+    void write(gamelog::Bytes&& bytes);
+
+private:
+    void writerLoop();
+
+    std::ostream& m_output;
+    std::mutex m_mutex;
+    std::condition_variable m_pendingChanged;
+    std::deque<gamelog::Bytes> m_pending;
+    bool m_stopped{false};
+    std::thread m_writerThread;
+};
+
+// Games encoded by one thread. They are handed over to the writer once the buffer grows past the threshold and when
+// the buffer is destroyed.
+class GameLogBuffer
+{
+public:
+    static constexpr std::size_t defaultFlushThreshold = 64 * 1024;
+
+    explicit GameLogBuffer(GameLogWriter& writer, std::size_t flushThreshold = defaultFlushThreshold);
+    GameLogBuffer(const GameLogBuffer&) = delete;
+    GameLogBuffer(GameLogBuffer&&) = delete;
+    ~GameLogBuffer();
+
+    GameLogBuffer& operator=(const GameLogBuffer&) = delete;
+    GameLogBuffer& operator=(GameLogBuffer&&) = delete;
+
+    void add(const GameRecord&);
+    void flush();
+
+private:
+    GameLogWriter& m_writer;
+    const std::size_t m_flushThreshold;
+    gamelog::Bytes m_bytes;
+};
+
+// Reads records back in the order they were written. Moves are replayed on the way to recover captures and
+// promotions, std::runtime_error is thrown for a corrupted record.
+class GameLogReader
+{
+public:
+    explicit GameLogReader(std::istream& input);
+
+    std::optional<GameRecord> next();
+
+private:
+    std::istream& m_input;
+    gamelog::Bytes m_record;
+};
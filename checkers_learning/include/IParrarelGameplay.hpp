@@ -12,6 +12,7 @@ struct Battle
     unsigned int whitePlayerId{0};
     unsigned int blackPlayerId{0};
     GameResult result{GameResult::GameOn};
+    unsigned int generation{0};
 };
 
 using BattleList = std::vector<Battle>;
@@ -1,4 +1,5 @@
 #pragma once
+#include "GameLog.hpp"
 #include "IParrarelGameplay.hpp"
 #include "Types.hpp"
 
@@ -8,7 +9,8 @@
 class ParrarelGamePlay : public IParrarelGamePlay
 {
 public:
-    explicit ParrarelGamePlay(unsigned int maxNumberOfThreads);
+    // Every finished game is appended to the game log when a writer is given.
+    explicit ParrarelGamePlay(unsigned int maxNumberOfThreads, GameLogWriter* gameLogWriter = nullptr);
 
     void play(BattleList, BattleFinishCallback) override;
 
@@ -18,6 +20,7 @@ private:
     std::optional<Battle> fetchNextBattle();
 
     const unsigned int maxNumberOfThreads;
+    GameLogWriter* const gameLogWriter;
     BattleFinishCallback battleFinishCallback;
     BattleList battlesLeft;
     std::mutex mutex;
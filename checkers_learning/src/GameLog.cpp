@@ -0,0 +1,280 @@
+#include "GameLog.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+constexpr auto squareBits = 5u;
+constexpr auto squareMask = (1u << squareBits) - 1;
+constexpr auto inlineLandingsLimit = 7u;
+
+void encodeVarint(std::uint64_t value, gamelog::Bytes& bytes)
+{
+    while (value >= 0x80u)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(value | 0x80u));
+        value >>= 7u;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint8_t zigzag(int value)
+{
+    return static_cast<std::uint8_t>(value >= 0 ? 2 * value : -2 * value - 1);
+}
+
+int unzigzag(std::uint8_t value)
+{
+    return (value & 1u) != 0 ? -static_cast<int>((value + 1u) / 2) : static_cast<int>(value / 2);
+}
+
+void encodeMove(const Move& move, gamelog::Bytes& bytes)
+{
+    const auto inlineLandings = std::min<unsigned int>(move.landingsNumber, inlineLandingsLimit);
+    bytes.push_back(static_cast<std::uint8_t>(move.from | (inlineLandings << squareBits)));
+    if (inlineLandings == inlineLandingsLimit)
+    {
+        bytes.push_back(move.landingsNumber);
+    }
+    auto previousSquare = static_cast<int>(move.from);
+    for (auto landing = 0; landing < move.landingsNumber; landing++)
+    {
+        bytes.push_back(zigzag(move.landing(landing) - previousSquare));
+        previousSquare = move.landing(landing);
+    }
+}
+
+// Reads a record payload, throwing when it ends too early.
+class RecordCursor
+{
+public:
+    explicit RecordCursor(const gamelog::Bytes& bytes) : m_bytes(bytes) {}
+
+    std::uint8_t byte()
+    {
+        if (m_position == m_bytes.size())
+        {
+            throw std::runtime_error("Game log record is truncated");
+        }
+        return m_bytes[m_position++];
+    }
+
+    std::uint64_t varint()
+    {
+        std::uint64_t value = 0;
+        for (auto shift = 0u; shift < 64u; shift += 7u)
+        {
+            const auto nextByte = byte();
+            value |= static_cast<std::uint64_t>(nextByte & 0x7Fu) << shift;
+            if ((nextByte & 0x80u) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::runtime_error("Game log varint is too long");
+    }
+
+    bool atEnd() const { return m_position == m_bytes.size(); }
+
+private:
+    const gamelog::Bytes& m_bytes;
+    std::size_t m_position{0};
+};
+
+Move decodeMove(RecordCursor& cursor, const GameState& gameState, FigureColor color)
+{
+    const auto header = cursor.byte();
+    const auto from = static_cast<int>(header & squareMask);
+    auto landingsNumber = static_cast<unsigned int>(header >> squareBits);
+    if (landingsNumber == inlineLandingsLimit)
+    {
+        landingsNumber = cursor.byte();
+    }
+    if (landingsNumber > Move::maxLandingsNumber)
+    {
+        throw std::runtime_error("Game log move is corrupted");
+    }
+    auto encodedMove = Move::startingAt(from);
+    for (auto landing = 0u; landing < landingsNumber; landing++)
+    {
+        const auto square = encodedMove.to + unzigzag(cursor.byte());
+        if (square < 0 || square >= bitboard::squaresNumber)
+        {
+            throw std::runtime_error("Game log move is corrupted");
+        }
+        encodedMove.addLanding(square);
+    }
+
+    MoveBuffer legalMoves;
+    GameController(gameState).getMoveList(color, legalMoves);
+    for (const auto& move : legalMoves)
+    {
+        if (move.from == encodedMove.from && move.landings == encodedMove.landings &&
+            move.landingsNumber == encodedMove.landingsNumber)
+        {
+            return move;
+        }
+    }
+    throw std::runtime_error("Game log move is not legal");
+}
+
+std::optional<std::uint64_t> readVarint(std::istream& input)
+{
+    std::uint64_t value = 0;
+    for (auto shift = 0u; shift < 64u; shift += 7u)
+    {
+        const auto nextByte = input.get();
+        if (nextByte == std::istream::traits_type::eof())
+        {
+            if (shift == 0u)
+            {
+                return std::nullopt;
+            }
+            throw std::runtime_error("Game log record size is truncated");
+        }
+        value |= static_cast<std::uint64_t>(nextByte & 0x7F) << shift;
+        if ((nextByte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+    throw std::runtime_error("Game log varint is too long");
+}
+} // namespace
+
+namespace gamelog
+{
+void encode(const GameRecord& record, Bytes& bytes)
+{
+    Bytes payload;
+    payload.reserve(16 + 3 * record.moves.size());
+    encodeVarint(record.whitePlayerId, payload);
+    encodeVarint(record.blackPlayerId, payload);
+    encodeVarint(record.generation, payload);
+    payload.push_back(static_cast<std::uint8_t>(record.result));
+    encodeVarint(record.moves.size(), payload);
+    for (const auto& move : record.moves)
+    {
+        encodeMove(move, payload);
+    }
+    encodeVarint(payload.size(), bytes);
+    bytes.insert(bytes.end(), payload.begin(), payload.end());
+}
+} // namespace gamelog
+
+GameLogWriter::GameLogWriter(std::ostream& output) : m_output(output), m_writerThread(&GameLogWriter::writerLoop, this)
+{
+}
+
+GameLogWriter::~GameLogWriter()
+{
+    {
+        const std::lock_guard lockGuard{m_mutex};
+        m_stopped = true;
+    }
+    m_pendingChanged.notify_one();
+    m_writerThread.join();
+    m_output.flush();
+}
+
+void GameLogWriter::write(gamelog::Bytes&& bytes)
+{
+    {
+        const std::lock_guard lockGuard{m_mutex};
+        m_pending.push_back(std::move(bytes));
+    }
+    m_pendingChanged.notify_one();
+}
+
+void GameLogWriter::writerLoop()
+{
+    std::unique_lock lock{m_mutex};
+    while (true)
+    {
+        m_pendingChanged.wait(lock, [this] { return m_stopped || !m_pending.empty(); });
+        if (m_pending.empty())
+        {
+            return;
+        }
+        auto bytes = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+        const auto* data = reinterpret_cast<const char*>(bytes.data()); // NOLINT
+        m_output.write(data, static_cast<std::streamsize>(bytes.size()));
+        lock.lock();
+    }
+}
+
+GameLogBuffer::GameLogBuffer(GameLogWriter& writer, std::size_t flushThreshold)
+    : m_writer(writer), m_flushThreshold(flushThreshold)
+{
+}
+
+GameLogBuffer::~GameLogBuffer()
+{
+    flush();
+}
+
+void GameLogBuffer::add(const GameRecord& record)
+{
+    gamelog::encode(record, m_bytes);
+    if (m_bytes.size() >= m_flushThreshold)
+    {
+        flush();
+    }
+}
+
+void GameLogBuffer::flush()
+{
+    if (m_bytes.empty())
+    {
+        return;
+    }
+    m_writer.write(std::move(m_bytes));
+    m_bytes = gamelog::Bytes{};
+}
+
+GameLogReader::GameLogReader(std::istream& input) : m_input(input) {}
+
+std::optional<GameRecord> GameLogReader::next()
+{
+    const auto recordSize = readVarint(m_input);
+    if (!recordSize)
+    {
+        return std::nullopt;
+    }
+    m_record.resize(*recordSize);
+    m_input.read(reinterpret_cast<char*>(m_record.data()), static_cast<std::streamsize>(m_record.size())); // NOLINT
+    if (static_cast<std::uint64_t>(m_input.gcount()) != *recordSize)
+    {
+        throw std::runtime_error("Game log record is truncated");
+    }
+
+    RecordCursor cursor{m_record};
+    GameRecord record;
+    record.whitePlayerId = static_cast<unsigned int>(cursor.varint());
+    record.blackPlayerId = static_cast<unsigned int>(cursor.varint());
+    record.generation = static_cast<unsigned int>(cursor.varint());
+    const auto result = cursor.byte();
+    if (result > static_cast<std::uint8_t>(GameResult::Draw))
+    {
+        throw std::runtime_error("Game log result is corrupted");
+    }
+    record.result = static_cast<GameResult>(result);
+    const auto movesNumber = cursor.varint();
+    GameState gameState;
+    auto color = FigureColor::White;
+    for (auto moveNumber = 0u; moveNumber < movesNumber; moveNumber++)
+    {
+        const auto move = decodeMove(cursor, gameState, color);
+        gameState.makeMove(move);
+        record.moves.push_back(move);
+        color = FigureState::flipColor(color);
+    }
+    if (!cursor.atEnd())
+    {
+        throw std::runtime_error("Game log record has trailing bytes");
+    }
+    return record;
+}
@@ -186,7 +186,8 @@ void GeneticAlgorithm::freeForAll()
                           std::move(blackPlayerStrategy),
                           whitePlayerIterator,
                           blackPlayerIterator,
-                          GameResult::GameOn};
+                          GameResult::GameOn,
+                          currentGeneration};
             battleList.emplace_back(std::move(battle));
         }
     }
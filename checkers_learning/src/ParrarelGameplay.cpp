@@ -8,7 +8,8 @@
 #include "GamePlay.hpp"
 #include "Helpers.hpp"
 
-ParrarelGamePlay::ParrarelGamePlay(unsigned int maxNumberOfThreads) : maxNumberOfThreads{maxNumberOfThreads}
+ParrarelGamePlay::ParrarelGamePlay(unsigned int maxNumberOfThreads, GameLogWriter* gameLogWriter)
+    : maxNumberOfThreads{maxNumberOfThreads}, gameLogWriter{gameLogWriter}
 {
     assert(maxNumberOfThreads > 0); // NOLINT
 }
@@ -34,6 +35,11 @@ void ParrarelGamePlay::play(BattleList battleList, BattleFinishCallback callback
 
 void ParrarelGamePlay::threadLoop()
 {
+    std::optional<GameLogBuffer> gameLogBuffer;
+    if (gameLogWriter != nullptr)
+    {
+        gameLogBuffer.emplace(*gameLogWriter);
+    }
     while (true)
     {
         auto battle = fetchNextBattle();
@@ -42,15 +48,31 @@ void ParrarelGamePlay::threadLoop()
             break;
         }
         GameState gameState;
-        GamePlay gameplay{gameState,
-                          [&battle](const InitialGameState& initialGameState, const std::vector<GameStateWithMove>&) {
-                              return battle->whitePlayerStrategy.getMove(initialGameState, FigureColor::White);
-                          },
-                          [&battle](const InitialGameState& initialGameState, const std::vector<GameStateWithMove>&) {
-                              return battle->blackPlayerStrategy.getMove(initialGameState, FigureColor::Black);
-                          }};
+        GamePlay gameplay{
+            gameState,
+            [&battle](
+                const InitialGameState& initialGameState,
+                const PossibleMoves& possibleMoves,
+                const PositionHistory& gameHistory) {
+                return battle->whitePlayerStrategy
+                    .getMove(initialGameState, possibleMoves, FigureColor::White, gameHistory)
+                    .value_or(possibleMoves.size());
+            },
+            [&battle](
+                const InitialGameState& initialGameState,
+                const PossibleMoves& possibleMoves,
+                const PositionHistory& gameHistory) {
+                return battle->blackPlayerStrategy
+                    .getMove(initialGameState, possibleMoves, FigureColor::Black, gameHistory)
+                    .value_or(possibleMoves.size());
+            }};
         const auto gameResult = gameplay.start();
         battle->result = gameResult;
+        if (gameLogBuffer)
+        {
+            gameLogBuffer->add(GameRecord{
+                battle->whitePlayerId, battle->blackPlayerId, battle->generation, gameResult, gameplay.playedMoves()});
+        }
         battleFinishCallback(battle.value());
     }
 }
@@ -69,5 +91,6 @@ std::optional<Battle> ParrarelGamePlay::fetchNextBattle()
                   std::move(lastBattle.blackPlayerStrategy),
                   lastBattle.whitePlayerId,
                   lastBattle.blackPlayerId,
-                  lastBattle.result};
+                  lastBattle.result,
+                  lastBattle.generation};
 }
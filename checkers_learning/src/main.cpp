@@ -1,3 +1,4 @@
+#include <fstream>
 #include <thread>
 #include "GeneticAlgorithm.hpp"
 
@@ -15,24 +16,33 @@ int main(int, char*[])
     constexpr auto regenerationLimit = 15u;
     constexpr auto mutatiosLimit = 3u;
     constexpr auto minimaxDeep = 5u;
+    constexpr auto nodesBudget = 1'000'000u;
     constexpr auto generationsNumber = 50u;
     const auto threadsNumber = std::thread::hardware_concurrency();
     const std::string resultFile = "bestGenotype.txt";
+    const std::string gameLogFile = "games.log";
 
     Logger::log("Using:");
     Logger::log("\tPopulation Limit: ", populationLimit);
     Logger::log("\tRegenerationLimit Limit: ", regenerationLimit);
     Logger::log("\tMutatiosLimit Limit: ", mutatiosLimit);
     Logger::log("\tMinimaxDeep Limit: ", minimaxDeep);
+    Logger::log("\tNodes Budget: ", nodesBudget);
     Logger::log("\tGenerationsNumber Limit: ", generationsNumber);
     Logger::log("\tThreads: ", threadsNumber);
+    Logger::log("\tGame log: ", gameLogFile);
     Logger::log();
     MetricsCalculator metricCalculator;
 
     const auto startTime = std::chrono::high_resolution_clock::now();
 
-    ParrarelGamePlay parrarelGameplay{threadsNumber};
-    Strategy strategy;
+    std::ofstream gameLog(gameLogFile, std::ofstream::out | std::ofstream::app | std::ofstream::binary);
+    GameLogWriter gameLogWriter{gameLog};
+    ParrarelGamePlay parrarelGameplay{threadsNumber, &gameLogWriter};
+    // Every move is searched with the same node budget, so bushy genotypes cannot make their games much longer.
+    SearchOptions searchOptions;
+    searchOptions.nodesBudget = nodesBudget;
+    Strategy strategy{searchOptions};
     std::random_device rd;
     std::mt19937 gen{rd()};
     RandomEngine randomEngine(gen);
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "GameLog.hpp"
+#include "GamePlay.hpp"
+
+namespace
+{
+GameRecord playGame(unsigned int whitePlayerId, unsigned int blackPlayerId, unsigned int generation)
+{
+    GameState gameState;
+    GamePlay gamePlay{
+        gameState,
+        [](const InitialGameState&, const PossibleMoves&, const PositionHistory&) { return MoveIndex{0}; },
+        [](const InitialGameState&, const PossibleMoves& possibleMoves, const PositionHistory&) {
+            return possibleMoves.size() - 1;
+        }};
+    const auto result = gamePlay.start();
+    return GameRecord{whitePlayerId, blackPlayerId, generation, result, gamePlay.playedMoves()};
+}
+
+void expectSameRecords(const GameRecord& first, const GameRecord& second)
+{
+    EXPECT_EQ(first.whitePlayerId, second.whitePlayerId);
+    EXPECT_EQ(first.blackPlayerId, second.blackPlayerId);
+    EXPECT_EQ(first.generation, second.generation);
+    EXPECT_EQ(first.result, second.result);
+    EXPECT_EQ(first.moves, second.moves);
+}
+} // namespace
+
+TEST(GameLog, ShouldReadBackWrittenGames)
+{
+    const auto record = playGame(3, 7, 300);
+    ASSERT_FALSE(record.moves.empty());
+    const GameRecord emptyRecord{1, 2, 0, GameResult::Draw, {}};
+
+    std::stringstream log;
+    {
+        GameLogWriter writer{log};
+        GameLogBuffer buffer{writer};
+        buffer.add(record);
+        buffer.add(emptyRecord);
+    }
+
+    GameLogReader reader{log};
+    const auto firstRecord = reader.next();
+    ASSERT_TRUE(firstRecord.has_value());
+    expectSameRecords(*firstRecord, record);
+    const auto secondRecord = reader.next();
+    ASSERT_TRUE(secondRecord.has_value());
+    expectSameRecords(*secondRecord, emptyRecord);
+    EXPECT_FALSE(reader.next().has_value());
+}
+
+TEST(GameLog, ShouldEncodeQuietMoveInTwoBytes)
+{
+    const auto moveList = GameController(GameState{}).getMoveList(FigureColor::White);
+    gamelog::Bytes bytes;
+    gamelog::encode(GameRecord{0, 0, 0, GameResult::GameOn, {moveList.front()}}, bytes);
+    // Size, two player ids, generation, result, moves number and the move itself.
+    EXPECT_EQ(bytes.size(), 1 + 3 + 1 + 1 + 2);
+}
+
+TEST(GameLog, ShouldCollectGamesOfManyThreadsThroughOneWriter)
+{
+    constexpr auto threadsNumber = 4u;
+    constexpr auto gamesPerThread = 25u;
+    const auto record = playGame(0, 0, 0);
+
+    std::stringstream log;
+    {
+        GameLogWriter writer{log};
+        std::vector<std::thread> threads;
+        for (auto thread = 0u; thread < threadsNumber; thread++)
+        {
+            threads.emplace_back([&writer, &record, thread] {
+                GameLogBuffer buffer{writer, thread % 2 == 0 ? 1 : GameLogBuffer::defaultFlushThreshold};
+                for (auto game = 0u; game < gamesPerThread; game++)
+                {
+                    auto threadRecord = record;
+                    threadRecord.whitePlayerId = thread;
+                    threadRecord.blackPlayerId = game;
+                    buffer.add(threadRecord);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::vector<unsigned int> gamesOfThread(threadsNumber, 0);
+    GameLogReader reader{log};
+    while (const auto readRecord = reader.next())
+    {
+        ASSERT_LT(readRecord->whitePlayerId, threadsNumber);
+        EXPECT_EQ(readRecord->blackPlayerId, gamesOfThread[readRecord->whitePlayerId]++);
+        EXPECT_EQ(readRecord->moves, record.moves);
+    }
+    EXPECT_EQ(gamesOfThread, std::vector<unsigned int>(threadsNumber, gamesPerThread));
+}
+
+TEST(GameLog, ShouldThrowOnCorruptedRecord)
+{
+    gamelog::Bytes bytes;
+    gamelog::encode(playGame(0, 0, 0), bytes);
+    bytes.back() ^= 0x1Fu;
+    std::stringstream log{std::string(bytes.begin(), bytes.end())};
+    GameLogReader reader{log};
+    EXPECT_THROW(reader.next(), std::runtime_error);
+
+    std::stringstream truncatedLog{std::string(bytes.begin(), bytes.end() - 1)};
+    GameLogReader truncatedReader{truncatedLog};
+    EXPECT_THROW(truncatedReader.next(), std::runtime_error);
+}